@@ -10,6 +10,11 @@ public class FGNetTarget : TargetRules
 		Type = TargetType.Game;
 		DefaultBuildSettings = BuildSettingsVersion.V2;
 
+		// Push model replication only exists with WITH_PUSH_MODEL, which needs a unique build environment and with that
+		// a source built engine. The editor target stays on the shared environment and replicates without push model.
+		BuildEnvironment = TargetBuildEnvironment.Unique;
+		bWithPushModel = true;
+
 		ExtraModuleNames.AddRange( new string[] { "FGNet" } );
 	}
 }
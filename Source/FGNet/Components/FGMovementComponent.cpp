@@ -1,7 +1,12 @@
 #include "FGMovementComponent.h"
 #include "../FGMovementStatics.h"
+#include "../FGNetStats.h"
 #include "GameFramework/Actor.h"
 #include "Engine/World.h"
+#include "Components/PrimitiveComponent.h"
+
+int32 UFGMovementComponent::NumSimulating = 0;
+int32 UFGMovementComponent::NumSleeping = 0;
 
 void UFGMovementComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
@@ -16,6 +21,20 @@ void UFGMovementComponent::TickComponent(float DeltaTime, enum ELevelTick TickTy
 	}
 }
 
+void UFGMovementComponent::OnUnregister()
+{
+	if (bIsSimulating)
+	{
+		SetAsleep(false);
+		bIsSimulating = false;
+		NumSimulating--;
+		DEC_DWORD_STAT(STAT_FGNet_SimulatedPawns);
+		UpdateSleepingStats();
+	}
+
+	Super::OnUnregister();
+}
+
 FFGFrameMovement UFGMovementComponent::CreateFrameMovement() const
 {
 	return FFGFrameMovement(UpdatedComponent);
@@ -23,12 +42,38 @@ FFGFrameMovement UFGMovementComponent::CreateFrameMovement() const
 
 void UFGMovementComponent::Move(FFGFrameMovement& FrameMovement)
 {
+	FGNET_SCOPE_CYCLE_COUNTER(MovementMove);
+
+	if (!bIsSimulating)
+	{
+		bIsSimulating = true;
+		NumSimulating++;
+		INC_DWORD_STAT(STAT_FGNet_SimulatedPawns);
+	}
+
+	FGNET_INC_COUNTER(MovementSteps);
+
+	// Parked on the same floor as last step, the sweeps would only find that floor again.
+	if (CanSleep(FrameMovement.GetMovementDelta()))
+	{
+		SetAsleep(true);
+		FGNET_INC_COUNTER(SleepingMovementSteps);
+
+		AccumulatedGravity = 0.0f;
+		FrameMovement.Hit = FloorHit;
+		FrameMovement.FinalLocation = UpdatedComponent->GetComponentLocation();
+		return;
+	}
+
+	SetAsleep(false);
 	Hit.Reset();
 
 	FVector Delta = GetMovementDelta(FrameMovement);
 	MoveUpdatedComponent(Delta, FacingRotationCurrent, true, &Hit);
 
-	if (Hit.bBlockingHit && FVector::DotProduct(FVector::UpVector, Hit.Normal) > 0.0f)
+	const bool bHitFloor = Hit.bBlockingHit && FVector::DotProduct(FVector::UpVector, Hit.Normal) > 0.0f;
+	const FHitResult FloorCandidate = Hit;
+	if (bHitFloor)
 	{
 		AccumulatedGravity = 0.0f;
 		Delta = GetMovementDelta(FrameMovement);
@@ -36,13 +81,147 @@ void UFGMovementComponent::Move(FFGFrameMovement& FrameMovement)
 
 	SlideAlongSurface(Delta, 1.0f - Hit.Time, Hit.Normal, Hit);
 
+	if (bHitFloor)
+		CacheFloor(FloorCandidate);
+	else
+		bHasFloor = false;
+
 	FrameMovement.Hit = Hit;
 	FrameMovement.FinalLocation = UpdatedComponent->GetComponentLocation();
 }
 
-void UFGMovementComponent::ApplyGravity()
+int32 UFGMovementComponent::AdvanceSimulationTime(float DeltaTime)
+{
+	const float StepTime = GetFixedStepTime();
+	SimulationTimeAccumulator += DeltaTime;
+
+	int32 NumSteps = FMath::FloorToInt(SimulationTimeAccumulator / StepTime);
+	SimulationTimeAccumulator -= NumSteps * StepTime;
+
+	if (NumSteps > MaxSubsteps)
+	{
+		NumSteps = MaxSubsteps;
+	}
+
+	return NumSteps;
+}
+
+void UFGMovementComponent::ResetSimulationTime()
+{
+	SimulationTimeAccumulator = 0.0f;
+	bHasStepStart = false;
+}
+
+void UFGMovementComponent::BeginSimulationStep()
+{
+	if (UpdatedComponent == nullptr)
+		return;
+
+	StepStartLocation = UpdatedComponent->GetComponentLocation();
+	StepStartRotation = UpdatedComponent->GetComponentQuat();
+	bHasStepStart = true;
+}
+
+void UFGMovementComponent::AddVisualComponent(USceneComponent* Component, bool bInterpolateRotation)
+{
+	if (Component == nullptr)
+		return;
+
+	FVisualComponent& VisualComponent = VisualComponents.AddDefaulted_GetRef();
+	VisualComponent.Component = Component;
+	VisualComponent.RelativeTransform = Component->GetRelativeTransform();
+	VisualComponent.bInterpolateRotation = bInterpolateRotation;
+}
+
+void UFGMovementComponent::UpdateVisualInterpolation()
+{
+	if (UpdatedComponent == nullptr || !bHasStepStart)
+		return;
+
+	const FVector SimulatedLocation = UpdatedComponent->GetComponentLocation();
+	const FQuat SimulatedRotation = UpdatedComponent->GetComponentQuat();
+	const float Alpha = FMath::Clamp(SimulationTimeAccumulator / GetFixedStepTime(), 0.0f, 1.0f);
+	const FVector VisualLocation = FMath::Lerp(StepStartLocation, SimulatedLocation, Alpha);
+	const FQuat VisualRotation = FQuat::Slerp(StepStartRotation, SimulatedRotation, Alpha);
+
+	for (const FVisualComponent& VisualComponent : VisualComponents)
+	{
+		USceneComponent* Component = VisualComponent.Component.Get();
+		if (Component == nullptr)
+			continue;
+
+		// Relative transform that puts the component where it would be if the root were at the visual transform.
+		const FQuat ParentRotation = VisualComponent.bInterpolateRotation ? VisualRotation : SimulatedRotation;
+		const FVector WorldLocation = VisualLocation + ParentRotation.RotateVector(VisualComponent.RelativeTransform.GetLocation());
+		const FVector RelativeLocation = SimulatedRotation.UnrotateVector(WorldLocation - SimulatedLocation);
+		const FQuat RelativeRotation = SimulatedRotation.Inverse() * ParentRotation * VisualComponent.RelativeTransform.GetRotation();
+		Component->SetRelativeLocationAndRotation(RelativeLocation, RelativeRotation);
+	}
+}
+
+void UFGMovementComponent::WakeUp()
+{
+	bHasFloor = false;
+	SetAsleep(false);
+}
+
+bool UFGMovementComponent::CanSleep(const FVector& Delta) const
+{
+	if (!bHasFloor || Delta.SizeSquared() > FMath::Square(SleepDistanceThreshold))
+		return false;
+
+	const UPrimitiveComponent* Floor = FloorComponent.Get();
+	if (Floor == nullptr || Floor->GetCollisionEnabled() == ECollisionEnabled::NoCollision)
+		return false;
+
+	// Anything that moved the pawn or its floor since it landed invalidates the cached floor.
+	return UpdatedComponent->GetComponentLocation().Equals(FloorRestLocation)
+		&& FacingRotationCurrent.Equals(FloorRestRotation)
+		&& Floor->GetComponentTransform().Equals(FloorTransform);
+}
+
+void UFGMovementComponent::CacheFloor(const FHitResult& InFloorHit)
+{
+	UPrimitiveComponent* Floor = InFloorHit.GetComponent();
+	bHasFloor = Floor != nullptr;
+	if (!bHasFloor)
+		return;
+
+	FloorComponent = Floor;
+	FloorHit = InFloorHit;
+	FloorTransform = Floor->GetComponentTransform();
+	FloorRestLocation = UpdatedComponent->GetComponentLocation();
+	FloorRestRotation = FacingRotationCurrent;
+}
+
+void UFGMovementComponent::SetAsleep(bool bInIsAsleep)
+{
+	if (bIsAsleep == bInIsAsleep)
+		return;
+
+	bIsAsleep = bInIsAsleep;
+	if (bIsAsleep)
+	{
+		NumSleeping++;
+		INC_DWORD_STAT(STAT_FGNet_SleepingPawns);
+	}
+	else
+	{
+		NumSleeping--;
+		DEC_DWORD_STAT(STAT_FGNet_SleepingPawns);
+	}
+
+	UpdateSleepingStats();
+}
+
+void UFGMovementComponent::UpdateSleepingStats() const
+{
+	CSV_CUSTOM_STAT(FGNet, SleepingPawnsPercent, NumSimulating > 0 ? 100.0f * NumSleeping / NumSimulating : 0.0f, ECsvCustomStatOp::Set);
+}
+
+void UFGMovementComponent::ApplyGravity(float DeltaTime)
 {
-	AccumulatedGravity += Gravity * GetWorld()->GetDeltaSeconds();
+	AccumulatedGravity += Gravity * DeltaTime;
 }
 
 void UFGMovementComponent::SetFacingRotation(const FRotator& InFacingRotation, float InRotationSpeed)
@@ -12,15 +12,51 @@ class FGNET_API UFGMovementComponent : public UMovementComponent
 public:
 
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void OnUnregister() override;
 
 	FFGFrameMovement CreateFrameMovement() const;
 
 	void Move(FFGFrameMovement& FrameMovement);
-	void ApplyGravity();
+	void ApplyGravity(float DeltaTime);
 
 	UPROPERTY(EditAnywhere, Category = Movement)
 		float Gravity = 30.0f;
 
+	// A pawn standing on a floor that moves less than this in a step goes to sleep and skips its sweeps, until it gets
+	// input, turns, is moved by something else or the floor it stands on moves.
+	UPROPERTY(EditAnywhere, Category = "Movement|Sleep", meta = (ClampMin = 0.0))
+		float SleepDistanceThreshold = 0.01f;
+
+	bool IsAsleep() const { return bIsAsleep; }
+
+	// Drops the cached floor, the next move sweeps again.
+	void WakeUp();
+
+	// Movement is simulated in fixed steps of 1 / SimulationRate seconds, whatever the frame rate is, so every
+	// machine integrates the same way and the cost doesn't grow with the frame rate.
+	UPROPERTY(EditAnywhere, Category = "Movement|Fixed Step", meta = (ClampMin = 1.0))
+		float SimulationRate = 60.0f;
+
+	// Steps beyond this in a single frame are dropped, so one slow frame can't make the next ones slower.
+	UPROPERTY(EditAnywhere, Category = "Movement|Fixed Step", meta = (ClampMin = 1))
+		int32 MaxSubsteps = 4;
+
+	float GetFixedStepTime() const { return 1.0f / SimulationRate; }
+
+	// Adds the frame time to the accumulator and returns how many fixed steps to simulate this frame.
+	int32 AdvanceSimulationTime(float DeltaTime);
+
+	// Drops the partial step in the accumulator, the next frame starts a fresh step.
+	void ResetSimulationTime();
+
+	// Call before simulating each step, the visual interpolation blends from where the last step started.
+	void BeginSimulationStep();
+
+	// Visual components are drawn between the last two simulated steps, by how far the accumulator is into the next
+	// step. Their relative transform is the one they have when they're added.
+	void AddVisualComponent(USceneComponent* Component, bool bInterpolateRotation);
+	void UpdateVisualInterpolation();
+
 	FVector GetGravityAsVector() const { return FVector(0.0f, 0.0f, AccumulatedGravity); }
 	FRotator GetFacingRotation() const { return FacingRotationCurrent; }
 	FVector GetFacingDirection() const { return FacingRotationCurrent.Vector(); }
@@ -33,6 +69,40 @@ private:
 	void Internal_SetFacingRotation(const FRotator& InFacingRotation, float InRotationSpeed);
 	FVector GetMovementDelta(const FFGFrameMovement& FrameMovement) const;
 
+	struct FVisualComponent
+	{
+		TWeakObjectPtr<USceneComponent> Component;
+		FTransform RelativeTransform;
+		bool bInterpolateRotation = true;
+	};
+
+	TArray<FVisualComponent> VisualComponents;
+
+	float SimulationTimeAccumulator = 0.0f;
+	FVector StepStartLocation = FVector::ZeroVector;
+	FQuat StepStartRotation = FQuat::Identity;
+	bool bHasStepStart = false;
+
+	bool CanSleep(const FVector& Delta) const;
+	void CacheFloor(const FHitResult& FloorHit);
+	void SetAsleep(bool bInIsAsleep);
+	void UpdateSleepingStats() const;
+
+	// The floor the pawn last landed on, with where the pawn and the floor were at that time.
+	TWeakObjectPtr<UPrimitiveComponent> FloorComponent;
+	FHitResult FloorHit;
+	FTransform FloorTransform;
+	FVector FloorRestLocation = FVector::ZeroVector;
+	FRotator FloorRestRotation = FRotator::ZeroRotator;
+	bool bHasFloor = false;
+
+	bool bIsAsleep = false;
+	bool bIsSimulating = false;
+
+	// Every simulating component on this machine, for the sleeping pawns stats.
+	static int32 NumSimulating;
+	static int32 NumSleeping;
+
 	FHitResult Hit;
 	FRotator FacingRotationCurrent;
 	FRotator FacingRotationTarget;
@@ -0,0 +1,130 @@
+#include "FGCorrectionTelemetry.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "../FGNet.h"
+
+FFGHistogram::FFGHistogram(const TCHAR* InName, const TCHAR* InUnit, float InBucketSize, int32 InNumBuckets)
+	: Name(InName)
+	, Unit(InUnit)
+	, BucketSize(InBucketSize)
+{
+	Buckets.SetNumZeroed(FMath::Max(InNumBuckets, 1));
+}
+
+void FFGHistogram::Add(float Value)
+{
+	const int32 Bucket = FMath::Clamp(FMath::FloorToInt(Value / BucketSize), 0, Buckets.Num() - 1);
+	Buckets[Bucket]++;
+	Count++;
+	Sum += Value;
+	Max = Count == 1 ? Value : FMath::Max(Max, Value);
+}
+
+void FFGHistogram::Reset()
+{
+	for (int32& Bucket : Buckets)
+	{
+		Bucket = 0;
+	}
+
+	Count = 0;
+	Sum = 0.0;
+	Max = 0.0f;
+}
+
+float FFGHistogram::GetPercentile(float Percentile) const
+{
+	if (Count == 0)
+		return 0.0f;
+
+	const int32 Rank = FMath::Max(FMath::CeilToInt(Percentile * Count), 1);
+	int32 NumBelow = 0;
+	for (int32 Bucket = 0; Bucket < Buckets.Num(); ++Bucket)
+	{
+		NumBelow += Buckets[Bucket];
+		if (NumBelow >= Rank)
+			return FMath::Min((Bucket + 1) * BucketSize, Max);
+	}
+
+	return Max;
+}
+
+FString FFGHistogram::GetSummary() const
+{
+	return FString::Printf(TEXT("%s (%s): %d, mean %.2f, p50 %.2f, p90 %.2f, p99 %.2f, max %.2f"), Name, Unit, Count,
+		GetMean(), GetPercentile(0.5f), GetPercentile(0.9f), GetPercentile(0.99f), GetMax());
+}
+
+void FFGHistogram::AppendCsv(TArray<FString>& OutLines) const
+{
+	for (int32 Bucket = 0; Bucket < Buckets.Num(); ++Bucket)
+	{
+		const bool bIsLast = Bucket == Buckets.Num() - 1;
+		OutLines.Add(FString::Printf(TEXT("%s,%.3f,%s,%d"), Name, Bucket * BucketSize,
+			bIsLast ? TEXT("inf") : *FString::Printf(TEXT("%.3f"), (Bucket + 1) * BucketSize), Buckets[Bucket]));
+	}
+}
+
+FFGHistogram FFGCorrectionTelemetry::RocketCorrectionAngle(TEXT("RocketCorrectionAngle"), TEXT("deg"), 0.5f, 60);
+FFGHistogram FFGCorrectionTelemetry::RocketConvergeTime(TEXT("RocketConvergeTime"), TEXT("s"), 0.05f, 40);
+FFGHistogram FFGCorrectionTelemetry::PlayerCorrectionError(TEXT("PlayerCorrectionError"), TEXT("cm"), 2.0f, 100);
+
+void FFGCorrectionTelemetry::Reset()
+{
+	RocketCorrectionAngle.Reset();
+	RocketConvergeTime.Reset();
+	PlayerCorrectionError.Reset();
+}
+
+void FFGCorrectionTelemetry::GetSummary(TArray<FString>& OutLines)
+{
+	OutLines.Add(RocketCorrectionAngle.GetSummary());
+	OutLines.Add(RocketConvergeTime.GetSummary());
+	OutLines.Add(PlayerCorrectionError.GetSummary());
+}
+
+FString FFGCorrectionTelemetry::Dump()
+{
+	TArray<FString> Lines;
+	Lines.Add(TEXT("Histogram,BucketStart,BucketEnd,Count"));
+	RocketCorrectionAngle.AppendCsv(Lines);
+	RocketConvergeTime.AppendCsv(Lines);
+	PlayerCorrectionError.AppendCsv(Lines);
+
+	const FString FileName = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("FGTelemetry"), FString::Printf(TEXT("Corrections-%s.csv"), *FDateTime::Now().ToString()));
+	return FFileHelper::SaveStringArrayToFile(Lines, *FileName) ? FileName : FString();
+}
+
+static void CorrectionTelemetryCommand(const TArray<FString>& Args)
+{
+	const FString Action = Args.Num() > 0 ? Args[0] : FString();
+	if (Action == TEXT("reset"))
+	{
+		FFGCorrectionTelemetry::Reset();
+		return;
+	}
+
+	if (Action == TEXT("dump"))
+	{
+		const FString FileName = FFGCorrectionTelemetry::Dump();
+		if (FileName.IsEmpty())
+			UE_LOG(LogFGNet, Warning, TEXT("Could not write the correction telemetry."));
+		else
+			UE_LOG(LogFGNet, Display, TEXT("Correction telemetry written to %s"), *FileName);
+		return;
+	}
+
+	TArray<FString> Lines;
+	FFGCorrectionTelemetry::GetSummary(Lines);
+	for (const FString& Line : Lines)
+	{
+		UE_LOG(LogFGNet, Display, TEXT("%s"), *Line);
+	}
+}
+
+static FAutoConsoleCommand CorrectionTelemetryConsoleCommand(
+	TEXT("FGNet.CorrectionTelemetry"),
+	TEXT("Logs the prediction correction histograms. 'dump' writes them to Saved/FGTelemetry as CSV, 'reset' clears them."),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&CorrectionTelemetryCommand));
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Values counted in fixed width buckets, the last bucket also holds everything above the range. Mean and max are
+// exact, percentiles are the upper edge of the bucket they fall in.
+class FGNET_API FFGHistogram
+{
+public:
+	FFGHistogram(const TCHAR* InName, const TCHAR* InUnit, float InBucketSize, int32 InNumBuckets);
+
+	void Add(float Value);
+	void Reset();
+
+	int32 Num() const { return Count; }
+	float GetMean() const { return Count > 0 ? static_cast<float>(Sum / Count) : 0.0f; }
+	float GetMax() const { return Max; }
+	float GetPercentile(float Percentile) const;
+
+	const TCHAR* GetName() const { return Name; }
+
+	// One line with count, mean, p50, p90, p99 and max.
+	FString GetSummary() const;
+
+	// One "name,bucket start,bucket end,count" line per bucket.
+	void AppendCsv(TArray<FString>& OutLines) const;
+
+private:
+	const TCHAR* Name;
+	const TCHAR* Unit;
+	float BucketSize;
+	TArray<int32> Buckets;
+	int32 Count = 0;
+	double Sum = 0.0;
+	float Max = 0.0f;
+};
+
+// How far predictions were off when the server corrected them, on this machine since startup or the last reset.
+// Query it with FGNet.CorrectionTelemetry, which can also dump every histogram to Saved/FGTelemetry.
+struct FGNET_API FFGCorrectionTelemetry
+{
+	// Angle between the direction a predicted rocket was fired in and the server's direction, in degrees.
+	static FFGHistogram RocketCorrectionAngle;
+
+	// Time a corrected rocket took to turn to within RocketConvergedAngle of the server's direction, in seconds.
+	static FFGHistogram RocketConvergeTime;
+
+	// Distance between the predicted and the acknowledged location of a corrected player move.
+	static FFGHistogram PlayerCorrectionError;
+
+	static constexpr float RocketConvergedAngle = 0.5f;
+
+	static void Reset();
+	static void GetSummary(TArray<FString>& OutLines);
+
+	// Writes every histogram as CSV, returns the file name or an empty string if it couldn't be written.
+	static FString Dump();
+};
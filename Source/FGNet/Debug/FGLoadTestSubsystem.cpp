@@ -0,0 +1,234 @@
+#include "FGLoadTestSubsystem.h"
+#include "FGCorrectionTelemetry.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "../Player/FGPlayer.h"
+#include "../Subsystems/FGClockSyncSubsystem.h"
+#include "../FGNet.h"
+
+void UFGLoadTestSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+	if (!FParse::Value(CommandLine, TEXT("FGLoadTest="), Duration) || Duration <= 0.0f)
+		return;
+
+	WarmUp = IsRunningDedicatedServer() ? 10.0f : 0.0f;
+	FParse::Value(CommandLine, TEXT("FGLoadTestWarmUp="), WarmUp);
+	FParse::Value(CommandLine, TEXT("FGLoadTestBots="), NumBots);
+	FParse::Value(CommandLine, TEXT("FGLoadTestClient="), ClientExecutable);
+}
+
+void UFGLoadTestSubsystem::Tick(float DeltaTime)
+{
+	if (ElapsedTime == 0.0f && NumBots > 0 && GetWorld()->GetNetMode() == NM_DedicatedServer)
+	{
+		LaunchBots();
+	}
+
+	ElapsedTime += DeltaTime;
+
+	if (!bIsMeasuring)
+	{
+		if (ElapsedTime >= WarmUp)
+			StartMeasuring();
+		return;
+	}
+
+	FrameTimes.Add(FPlatformTime::ToMilliseconds(GGameThreadTime));
+
+	TimeUntilConnectionSample -= DeltaTime;
+	if (TimeUntilConnectionSample <= 0.0f)
+	{
+		TimeUntilConnectionSample = 1.0f;
+		SampleConnections();
+	}
+
+	if (ElapsedTime >= WarmUp + Duration)
+	{
+		bIsFinished = true;
+		WriteReport();
+		FPlatformMisc::RequestExit(false);
+	}
+}
+
+bool UFGLoadTestSubsystem::IsTickable() const
+{
+	if (IsTemplate() || Duration <= 0.0f || bIsFinished)
+		return false;
+
+	// Clients start out in a local world while they connect, only measure the one connected to the server.
+	const UWorld* World = GetWorld();
+	return World != nullptr && World->IsGameWorld() && (World->GetNetMode() == NM_DedicatedServer || World->GetNetMode() == NM_Client);
+}
+
+TStatId UFGLoadTestSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFGLoadTestSubsystem, STATGROUP_Tickables);
+}
+
+void UFGLoadTestSubsystem::LaunchBots()
+{
+	FString Executable = ClientExecutable;
+	FString Project;
+	if (Executable.IsEmpty())
+	{
+		if (FPlatformProperties::RequiresCookedData())
+		{
+			UE_LOG(LogFGNet, Error, TEXT("Load test: cooked servers can't run as a client, pass -FGLoadTestClient=<path to a client executable> to launch bots."));
+			return;
+		}
+
+		// The editor binary runs as a game client with the project.
+		Executable = FPlatformProcess::ExecutablePath();
+		Project = FString::Printf(TEXT("\"%s\" -game "), *FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath()));
+	}
+	else if (!FPaths::FileExists(Executable))
+	{
+		UE_LOG(LogFGNet, Error, TEXT("Load test: client executable %s doesn't exist, no bots launched."), *Executable);
+		return;
+	}
+
+	const FString ExtraParams = FParse::Param(FCommandLine::Get(), TEXT("FGUnlimitedRockets")) ? TEXT(" -FGUnlimitedRockets") : TEXT("");
+
+	// Bots measure from the moment they are connected, make sure they are done before the server shuts down.
+	const float BotDuration = FMath::Max(Duration - 5.0f, 1.0f);
+
+	for (int32 Index = 0; Index < NumBots; ++Index)
+	{
+		const FString Params = FString::Printf(TEXT("%s127.0.0.1:%d -nullrhi -nosound -unattended -log=FGBot%d.log -FGBot -FGBotSeed=%d -FGLoadTest=%.1f -FGLoadTestWarmUp=%.1f%s"),
+			*Project, GetWorld()->URL.Port, Index, Index + 1, BotDuration, WarmUp * 0.5f, *ExtraParams);
+
+		FProcHandle Handle = FPlatformProcess::CreateProc(*Executable, *Params, true, true, true, nullptr, 0, nullptr, nullptr);
+		if (!Handle.IsValid())
+		{
+			UE_LOG(LogFGNet, Error, TEXT("Load test: failed to launch bot %d."), Index);
+		}
+		FPlatformProcess::CloseProc(Handle);
+	}
+
+	UE_LOG(LogFGNet, Display, TEXT("Load test: launched %d bots, measuring for %.0f s after %.0f s warm up."), NumBots, Duration, WarmUp);
+}
+
+void UFGLoadTestSubsystem::StartMeasuring()
+{
+	bIsMeasuring = true;
+	FrameTimes.Reset();
+	FrameTimes.Reserve(FMath::CeilToInt(Duration * 120.0f));
+	ConnectionTraffic.Reset();
+
+	for (int32 Index = 0; Index < static_cast<int32>(EFGNetCounter::Num); ++Index)
+	{
+		CountersAtStart[Index] = FFGNetCounters::Totals[Index];
+	}
+}
+
+void UFGLoadTestSubsystem::SampleConnections()
+{
+	const UNetDriver* NetDriver = GetWorld()->GetNetDriver();
+	if (NetDriver == nullptr)
+		return;
+
+	auto Sample = [this](UNetConnection* Connection)
+	{
+		if (Connection == nullptr || Connection->State != USOCK_Open)
+			return;
+
+		FFGLoadTestConnectionTraffic& Traffic = ConnectionTraffic.FindOrAdd(Connection->LowLevelGetRemoteAddress(true));
+		Traffic.InBytesPerSecond += Connection->InBytesPerSecond;
+		Traffic.OutBytesPerSecond += Connection->OutBytesPerSecond;
+		Traffic.NumSamples++;
+	};
+
+	Sample(NetDriver->ServerConnection);
+	for (UNetConnection* Connection : NetDriver->ClientConnections)
+	{
+		Sample(Connection);
+	}
+}
+
+static float GetPercentile(const TArray<float>& SortedValues, float Percentile)
+{
+	if (SortedValues.Num() == 0)
+		return 0.0f;
+
+	const int32 Index = FMath::Clamp(FMath::CeilToInt(Percentile * SortedValues.Num()) - 1, 0, SortedValues.Num() - 1);
+	return SortedValues[Index];
+}
+
+void UFGLoadTestSubsystem::WriteReport()
+{
+	const bool bIsServer = GetWorld()->GetNetMode() == NM_DedicatedServer;
+
+	TArray<FString> Lines;
+	Lines.Add(FString::Printf(TEXT("FGNet load test report (%s, pid %u)"), bIsServer ? TEXT("server") : TEXT("client"), FPlatformProcess::GetCurrentProcessId()));
+	Lines.Add(FString::Printf(TEXT("Duration: %.1f s, frames: %d"), Duration, FrameTimes.Num()));
+
+	TArray<float> SortedFrameTimes = FrameTimes;
+	SortedFrameTimes.Sort();
+	Lines.Add(FString::Printf(TEXT("Game thread ms: p50 %.2f, p90 %.2f, p99 %.2f, max %.2f"),
+		GetPercentile(SortedFrameTimes, 0.5f), GetPercentile(SortedFrameTimes, 0.9f), GetPercentile(SortedFrameTimes, 0.99f), GetPercentile(SortedFrameTimes, 1.0f)));
+
+	int32 NumPlayers = 0;
+	for (TActorIterator<AFGPlayer> It(GetWorld()); It; ++It)
+	{
+		NumPlayers++;
+	}
+	Lines.Add(FString::Printf(TEXT("Players: %d, connections: %d"), NumPlayers, ConnectionTraffic.Num()));
+
+	for (const TPair<FString, FFGLoadTestConnectionTraffic>& Pair : ConnectionTraffic)
+	{
+		const FFGLoadTestConnectionTraffic& Traffic = Pair.Value;
+		Lines.Add(FString::Printf(TEXT("Connection %s: in %.0f B/s, out %.0f B/s"), *Pair.Key,
+			Traffic.InBytesPerSecond / FMath::Max(Traffic.NumSamples, 1), Traffic.OutBytesPerSecond / FMath::Max(Traffic.NumSamples, 1)));
+	}
+
+	for (int32 Index = 0; Index < static_cast<int32>(EFGNetCounter::Num); ++Index)
+	{
+		const int64 Count = FFGNetCounters::Totals[Index] - CountersAtStart[Index];
+		Lines.Add(FString::Printf(TEXT("%s: %lld (%.1f/s)"), FFGNetCounters::GetName(static_cast<EFGNetCounter>(Index)), Count, Count / Duration));
+	}
+
+	const int64 NumMovementSteps = FFGNetCounters::Get(EFGNetCounter::MovementSteps) - CountersAtStart[static_cast<int32>(EFGNetCounter::MovementSteps)];
+	const int64 NumSleepingSteps = FFGNetCounters::Get(EFGNetCounter::SleepingMovementSteps) - CountersAtStart[static_cast<int32>(EFGNetCounter::SleepingMovementSteps)];
+	Lines.Add(FString::Printf(TEXT("Sleeping pawns: %.1f%% of movement steps"), NumMovementSteps > 0 ? 100.0 * NumSleepingSteps / NumMovementSteps : 0.0));
+
+	for (TActorIterator<AFGPlayer> It(GetWorld()); It; ++It)
+	{
+		if (It->IsLocallyControlled())
+		{
+			Lines.Add(FString::Printf(TEXT("Correction error: %d corrections, mean %.2f, max %.2f"),
+				It->GetNumMoveCorrections(), It->GetMeanCorrectionError(), It->GetMaxCorrectionError()));
+			Lines.Add(FString::Printf(TEXT("Rocket confirm time ms: mean %.1f, max %.1f"),
+				It->GetMeanRocketConfirmTime() * 1000.0f, It->GetMaxRocketConfirmTime() * 1000.0f));
+		}
+	}
+
+	if (const UFGClockSyncSubsystem* ClockSync = GetWorld()->GetSubsystem<UFGClockSyncSubsystem>())
+	{
+		if (ClockSync->IsSynchronized())
+		{
+			Lines.Add(FString::Printf(TEXT("Clock sync: rtt %.1f ms, jitter %.1f ms, loss %.1f%%, server time offset %.3f s"),
+				ClockSync->GetRoundTripTime() * 1000.0f, ClockSync->GetJitter() * 1000.0f, ClockSync->GetLossRate() * 100.0f, ClockSync->GetServerTimeOffset()));
+		}
+	}
+
+	FFGCorrectionTelemetry::GetSummary(Lines);
+
+	for (const FString& Line : Lines)
+	{
+		UE_LOG(LogFGNet, Display, TEXT("%s"), *Line);
+	}
+
+	const FString FileName = FString::Printf(TEXT("%s-%u-%s.txt"), bIsServer ? TEXT("Server") : TEXT("Client"), FPlatformProcess::GetCurrentProcessId(), *FDateTime::Now().ToString());
+	FFileHelper::SaveStringArrayToFile(Lines, *FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("FGLoadTest"), FileName));
+}
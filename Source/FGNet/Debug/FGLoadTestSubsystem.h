@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "../FGNetStats.h"
+#include "FGLoadTestSubsystem.generated.h"
+
+struct FFGLoadTestConnectionTraffic
+{
+	double InBytesPerSecond = 0.0;
+	double OutBytesPerSecond = 0.0;
+	int32 NumSamples = 0;
+};
+
+// Headless load test. Active in game worlds when the process runs with -FGLoadTest=<seconds>, it measures for that
+// long after -FGLoadTestWarmUp=<seconds> (default 10 on servers, 0 on clients), writes a report to the log and to
+// Saved/FGLoadTest and exits. A server started with -FGLoadTestBots=<N> launches N -nullrhi bot clients on loopback,
+// running -FGLoadTestClient=<path>. The editor binary can run as its own client and uses itself when that's missing,
+// cooked server binaries can't and need the path to a client build.
+//
+// Server: <exe> [project] <map> -server -nullrhi -log -FGLoadTest=60 -FGLoadTestBots=32 [-FGLoadTestClient=<path>] [-FGUnlimitedRockets]
+UCLASS()
+class FGNET_API UFGLoadTestSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+private:
+	void LaunchBots();
+	void StartMeasuring();
+	void SampleConnections();
+	void WriteReport();
+
+	float Duration = 0.0f;
+	float WarmUp = 0.0f;
+	int32 NumBots = 0;
+	FString ClientExecutable;
+
+	float ElapsedTime = 0.0f;
+	float TimeUntilConnectionSample = 0.0f;
+	bool bIsMeasuring = false;
+	bool bIsFinished = false;
+
+	// Game thread time of every measured frame, in milliseconds.
+	TArray<float> FrameTimes;
+
+	TMap<FString, FFGLoadTestConnectionTraffic> ConnectionTraffic;
+
+	int64 CountersAtStart[static_cast<int32>(EFGNetCounter::Num)] = {};
+};
@@ -4,21 +4,25 @@
 #include "GameFramework/PlayerController.h"
 #include "GameFramework/PlayerState.h"
 #include "Misc/DefaultValueHelper.h"
+#include "../../Subsystems/FGClockSyncSubsystem.h"
+#include "../../Subsystems/FGNetConditionSubsystem.h"
 
 void UFGNetDebugWidget::UpdateNetworkSimulationSettings(const FFGBlueprintNetworkSimulationSettings& InPackets)
 {
 	if (UWorld* World = GetWorld())
 	{
-		if (World->GetNetDriver() != nullptr)
+		UFGNetConditionSubsystem* NetConditions = World->GetSubsystem<UFGNetConditionSubsystem>();
+		if (World->GetNetDriver() != nullptr && NetConditions != nullptr)
 		{
-			FPacketSimulationSettings PacketSimulation;
-			PacketSimulation.PktLagMin = InPackets.MinLatency;
-			PacketSimulation.PktLagMax = InPackets.MaxLatency;
-			PacketSimulation.PktLoss = InPackets.PacketLossPercentage;
-			PacketSimulation.PktIncomingLagMin = InPackets.MinLatency;
-			PacketSimulation.PktIncomingLagMax = InPackets.MaxLatency;
-			PacketSimulation.PktIncomingLoss = InPackets.PacketLossPercentage;
-			World->GetNetDriver()->SetPacketSimulationSettings(PacketSimulation);
+			// The widget only knows symmetric conditions, with the difference between min and max latency as jitter.
+			FFGNetConditions Conditions;
+			Conditions.UpLatency = InPackets.MinLatency;
+			Conditions.UpJitter = FMath::Max(InPackets.MaxLatency - InPackets.MinLatency, 0);
+			Conditions.UpLoss = InPackets.PacketLossPercentage;
+			Conditions.DownLatency = Conditions.UpLatency;
+			Conditions.DownJitter = Conditions.UpJitter;
+			Conditions.DownLoss = Conditions.UpLoss;
+			NetConditions->SetConditions(Conditions);
 
 			FFGBlueprintNetworkSimulationSettingsText SimulationSettingsText;
 			SimulationSettingsText.MaxLatency = FText::FromString(FString::FromInt(InPackets.MaxLatency));
@@ -34,7 +38,13 @@ void UFGNetDebugWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTim
 {
 	Super::NativeTick(MyGeometry, InDeltaTime);
 
-	if (APlayerController* PC = GetOwningPlayer())
+	const UFGClockSyncSubsystem* ClockSync = GetWorld() != nullptr ? GetWorld()->GetSubsystem<UFGClockSyncSubsystem>() : nullptr;
+	if (ClockSync != nullptr && ClockSync->IsSynchronized())
+	{
+		BP_UpdatePing(FMath::RoundToInt(ClockSync->GetRoundTripTime() * 1000.0f));
+		BP_UpdateConnectionQuality(ClockSync->GetRoundTripTime() * 1000.0f, ClockSync->GetJitter() * 1000.0f, ClockSync->GetLossRate() * 100.0f);
+	}
+	else if (APlayerController* PC = GetOwningPlayer())
 	{
 		if (APlayerState* PlayerState = PC->GetPlayerState<APlayerState>())
 		{
@@ -51,6 +51,10 @@ public:
 	UFUNCTION(BlueprintImplementableEvent, Category = Widget, meta = (DisplayName = "On Update Ping"))
 		void BP_UpdatePing(int32 Ping);
 
+	// Values of the clock sync, in milliseconds and percent. Only called on clients once the clock is synchronized.
+	UFUNCTION(BlueprintImplementableEvent, Category = Widget, meta = (DisplayName = "On Update Connection Quality"))
+		void BP_UpdateConnectionQuality(float RoundTripTime, float Jitter, float LossPercentage);
+
 	UFUNCTION(BlueprintImplementableEvent, Category = Widget, meta = (DisplayName = "On Show Widget"))
 		void BP_OnShowWidget();
 
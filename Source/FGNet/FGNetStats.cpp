@@ -0,0 +1,72 @@
+#include "FGNetStats.h"
+
+CSV_DEFINE_CATEGORY_MODULE(FGNET_API, FGNet, true);
+
+int64 FFGNetCounters::Totals[static_cast<int32>(EFGNetCounter::Num)] = {};
+
+const TCHAR* FFGNetCounters::GetName(EFGNetCounter Counter)
+{
+	switch (Counter)
+	{
+	case EFGNetCounter::MovementStateSent: return TEXT("MovementStateSent");
+	case EFGNetCounter::MovementStateReceived: return TEXT("MovementStateReceived");
+	case EFGNetCounter::MovesSent: return TEXT("MovesSent");
+	case EFGNetCounter::MovesReceived: return TEXT("MovesReceived");
+	case EFGNetCounter::MoveAckSent: return TEXT("MoveAckSent");
+	case EFGNetCounter::MoveAckReceived: return TEXT("MoveAckReceived");
+	case EFGNetCounter::FireRocketSent: return TEXT("FireRocketSent");
+	case EFGNetCounter::FireRocketReceived: return TEXT("FireRocketReceived");
+	case EFGNetCounter::MoveCorrections: return TEXT("MoveCorrections");
+	case EFGNetCounter::PickupsCollected: return TEXT("PickupsCollected");
+	case EFGNetCounter::MovementSteps: return TEXT("MovementSteps");
+	case EFGNetCounter::SleepingMovementSteps: return TEXT("SleepingMovementSteps");
+	case EFGNetCounter::ExplosionPoolHits: return TEXT("ExplosionPoolHits");
+	case EFGNetCounter::ExplosionPoolMisses: return TEXT("ExplosionPoolMisses");
+	case EFGNetCounter::ExplosionsCulled: return TEXT("ExplosionsCulled");
+	case EFGNetCounter::MovementStatesClamped: return TEXT("MovementStatesClamped");
+	case EFGNetCounter::MovementStatesRejected: return TEXT("MovementStatesRejected");
+	case EFGNetCounter::MovementSweeps: return TEXT("MovementSweeps");
+	default: return TEXT("Unknown");
+	}
+}
+
+DEFINE_STAT(STAT_FGNet_DormantActors);
+DEFINE_STAT(STAT_FGNet_DormancyWakes);
+DEFINE_STAT(STAT_FGNet_ActiveRockets);
+DEFINE_STAT(STAT_FGNet_PickupsCollected);
+DEFINE_STAT(STAT_FGNet_MoveCorrections);
+DEFINE_STAT(STAT_FGNet_SimulatedPawns);
+DEFINE_STAT(STAT_FGNet_SleepingPawns);
+DEFINE_STAT(STAT_FGNet_MovementSteps);
+DEFINE_STAT(STAT_FGNet_SleepingMovementSteps);
+DEFINE_STAT(STAT_FGNet_ExplosionPoolHits);
+DEFINE_STAT(STAT_FGNet_ExplosionPoolMisses);
+DEFINE_STAT(STAT_FGNet_ExplosionsCulled);
+DEFINE_STAT(STAT_FGNet_MovementStatesClamped);
+DEFINE_STAT(STAT_FGNet_MovementStatesRejected);
+DEFINE_STAT(STAT_FGNet_MovementSweeps);
+
+DEFINE_STAT(STAT_FGNet_MovementStateSent);
+DEFINE_STAT(STAT_FGNet_MovementStateReceived);
+DEFINE_STAT(STAT_FGNet_MovesSent);
+DEFINE_STAT(STAT_FGNet_MovesReceived);
+DEFINE_STAT(STAT_FGNet_MoveAckSent);
+DEFINE_STAT(STAT_FGNet_MoveAckReceived);
+DEFINE_STAT(STAT_FGNet_FireRocketSent);
+DEFINE_STAT(STAT_FGNet_FireRocketReceived);
+
+DEFINE_STAT(STAT_FGNet_PlayerTick);
+DEFINE_STAT(STAT_FGNet_MovementMove);
+DEFINE_STAT(STAT_FGNet_SnapshotInterpolation);
+DEFINE_STAT(STAT_FGNet_MoveReplay);
+DEFINE_STAT(STAT_FGNet_RocketTick);
+DEFINE_STAT(STAT_FGNet_RocketSimulation);
+DEFINE_STAT(STAT_FGNet_RocketRender);
+DEFINE_STAT(STAT_FGNet_PickupCollection);
+DEFINE_STAT(STAT_FGNet_PickupAnimation);
+DEFINE_STAT(STAT_FGNet_ServerSendMovementState);
+DEFINE_STAT(STAT_FGNet_MulticastSendMovementState);
+DEFINE_STAT(STAT_FGNet_ServerSendMoves);
+DEFINE_STAT(STAT_FGNet_ClientAckMove);
+DEFINE_STAT(STAT_FGNet_ServerFireRocket);
+DEFINE_STAT(STAT_FGNet_ApplyFiredRocket);
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+DECLARE_STATS_GROUP(TEXT("FGNet"), STATGROUP_FGNet, STATCAT_Advanced);
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(FGNET_API, FGNet);
+
+// Times the scope with a cycle stat for "stat FGNet" and a CSV timing stat of the same name for -csvprofile.
+#define FGNET_SCOPE_CYCLE_COUNTER(Name) \
+	SCOPE_CYCLE_COUNTER(STAT_FGNet_##Name); \
+	CSV_SCOPED_TIMING_STAT(FGNet, Name)
+
+// Events counted since startup, independent of the stats system so reports can read them in any build.
+enum class EFGNetCounter : uint8
+{
+	MovementStateSent,
+	MovementStateReceived,
+	MovesSent,
+	MovesReceived,
+	MoveAckSent,
+	MoveAckReceived,
+	FireRocketSent,
+	FireRocketReceived,
+	MoveCorrections,
+	PickupsCollected,
+	MovementSteps,
+	SleepingMovementSteps,
+	ExplosionPoolHits,
+	ExplosionPoolMisses,
+	ExplosionsCulled,
+	MovementStatesClamped,
+	MovementStatesRejected,
+	MovementSweeps,
+	Num
+};
+
+struct FGNET_API FFGNetCounters
+{
+	static int64 Totals[static_cast<int32>(EFGNetCounter::Num)];
+
+	static int64 Get(EFGNetCounter Counter) { return Totals[static_cast<int32>(Counter)]; }
+	static const TCHAR* GetName(EFGNetCounter Counter);
+};
+
+// Counts one event on a per frame counter stat, the CSV column of the same name and the running total.
+#define FGNET_INC_COUNTER(Name) \
+	INC_DWORD_STAT(STAT_FGNet_##Name); \
+	CSV_CUSTOM_STAT(FGNet, Name, 1, ECsvCustomStatOp::Accumulate); \
+	FFGNetCounters::Totals[static_cast<int32>(EFGNetCounter::Name)]++
+
+// Server only. Replicated FGNet actors currently dormant, which the net driver skips every tick.
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Dormant Actors Skipped"), STAT_FGNet_DormantActors, STATGROUP_FGNet, FGNET_API);
+
+// Server only. Dormant actors flushed this frame to send a change.
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Dormancy Wakes"), STAT_FGNet_DormancyWakes, STATGROUP_FGNet, FGNET_API);
+
+// Rockets taken from the pool and not released yet, as far as this machine's pool knows.
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Active Rockets"), STAT_FGNet_ActiveRockets, STATGROUP_FGNet, FGNET_API);
+
+// Server only. Pickups collected this frame.
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Pickups Collected"), STAT_FGNet_PickupsCollected, STATGROUP_FGNet, FGNET_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Move Corrections"), STAT_FGNet_MoveCorrections, STATGROUP_FGNet, FGNET_API);
+
+// Pawns simulating movement on this machine and how many of them are parked on a floor and skip their sweeps.
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Simulated Pawns"), STAT_FGNet_SimulatedPawns, STATGROUP_FGNet, FGNET_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Sleeping Pawns"), STAT_FGNet_SleepingPawns, STATGROUP_FGNet, FGNET_API);
+
+// Movement steps simulated this frame, and the ones skipped because the pawn was asleep.
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Movement Steps"), STAT_FGNet_MovementSteps, STATGROUP_FGNet, FGNET_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Sleeping Movement Steps"), STAT_FGNet_SleepingMovementSteps, STATGROUP_FGNet, FGNET_API);
+
+// Explosions played by an idle pooled component, by one that was still playing, and not played because they're out of view.
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Explosion Pool Hits"), STAT_FGNet_ExplosionPoolHits, STATGROUP_FGNet, FGNET_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Explosion Pool Misses"), STAT_FGNet_ExplosionPoolMisses, STATGROUP_FGNet, FGNET_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Explosions Culled"), STAT_FGNet_ExplosionsCulled, STATGROUP_FGNet, FGNET_API);
+
+// Server only. Client movement states that moved further than reachable, and the sweeps checking them against the world.
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Movement States Clamped"), STAT_FGNet_MovementStatesClamped, STATGROUP_FGNet, FGNET_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Movement States Rejected"), STAT_FGNet_MovementStatesRejected, STATGROUP_FGNet, FGNET_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Movement Sweeps"), STAT_FGNet_MovementSweeps, STATGROUP_FGNet, FGNET_API);
+
+// RPCs sent and received this frame, per type. Multicasts count once per call, not once per connection.
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("RPC Sent: Movement State"), STAT_FGNet_MovementStateSent, STATGROUP_FGNet, FGNET_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("RPC Received: Movement State"), STAT_FGNet_MovementStateReceived, STATGROUP_FGNet, FGNET_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("RPC Sent: Moves"), STAT_FGNet_MovesSent, STATGROUP_FGNet, FGNET_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("RPC Received: Moves"), STAT_FGNet_MovesReceived, STATGROUP_FGNet, FGNET_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("RPC Sent: Move Ack"), STAT_FGNet_MoveAckSent, STATGROUP_FGNet, FGNET_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("RPC Received: Move Ack"), STAT_FGNet_MoveAckReceived, STATGROUP_FGNet, FGNET_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("RPC Sent: Fire Rocket"), STAT_FGNet_FireRocketSent, STATGROUP_FGNet, FGNET_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("RPC Received: Fire Rocket"), STAT_FGNet_FireRocketReceived, STATGROUP_FGNet, FGNET_API);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Player Tick"), STAT_FGNet_PlayerTick, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Movement Move"), STAT_FGNet_MovementMove, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Snapshot Interpolation"), STAT_FGNet_SnapshotInterpolation, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Move Replay"), STAT_FGNet_MoveReplay, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Rocket Tick"), STAT_FGNet_RocketTick, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Rocket Simulation"), STAT_FGNet_RocketSimulation, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Rocket Render"), STAT_FGNet_RocketRender, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Pickup Collection"), STAT_FGNet_PickupCollection, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Pickup Animation"), STAT_FGNet_PickupAnimation, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Server_SendMovementState"), STAT_FGNet_ServerSendMovementState, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Multicast_SendMovementState"), STAT_FGNet_MulticastSendMovementState, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Server_SendMoves"), STAT_FGNet_ServerSendMoves, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Client_AckMove"), STAT_FGNet_ClientAckMove, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Server_FireRocket"), STAT_FGNet_ServerFireRocket, STATGROUP_FGNet, FGNET_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Apply Fired Rocket"), STAT_FGNet_ApplyFiredRocket, STATGROUP_FGNet, FGNET_API);
@@ -6,76 +6,133 @@
 #include "Components/StaticMeshComponent.h"
 #include "Engine/World.h"
 #include "TimerManager.h"
+#include "Net/UnrealNetwork.h"
+#include "FGNetStats.h"
+#include "Subsystems/FGPickupAnimationSubsystem.h"
+#include "Subsystems/FGPickupGridSubsystem.h"
 
 AFGPickup::AFGPickup()
 {
-	PrimaryActorTick.bStartWithTickEnabled = true;
-	PrimaryActorTick.bCanEverTick = true;
+	// Bob and spin are driven by UFGPickupAnimationSubsystem.
+	PrimaryActorTick.bCanEverTick = false;
 
 	RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("SceneRoot"));
 
 	SphereComponent = CreateDefaultSubobject<USphereComponent>(TEXT("Sphere"));
 	SphereComponent->SetupAttachment(RootComponent);
+	SphereComponent->SetCollisionProfileName(TEXT("NoCollision"));
+	SphereComponent->SetGenerateOverlapEvents(false);
 
 	MeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Mesh"));
 	MeshComponent->SetupAttachment(RootComponent);
+	MeshComponent->SetGenerateOverlapEvents(false);
+	MeshComponent->SetCollisionProfileName(TEXT("NoCollision"));
 
 	SetReplicates(true);
+	// Pickups are placed in the map, clients already have them.
+	NetDormancy = DORM_Initial;
 }
 
 void AFGPickup::BeginPlay()
 {
 	Super::BeginPlay();
 
-	SphereComponent->OnComponentBeginOverlap.AddDynamic(this, &AFGPickup::OverlapBegin);
 	CachedMeshRelativeLocation = MeshComponent->GetRelativeLocation();
+
+	// Nobody sees the animation on a dedicated server.
+	if (GetNetMode() != NM_DedicatedServer)
+	{
+		if (UFGPickupAnimationSubsystem* PickupAnimation = GetWorld()->GetSubsystem<UFGPickupAnimationSubsystem>())
+			PickupAnimation->RegisterPickup(this);
+	}
+
+	if (HasAuthority())
+	{
+		if (UFGPickupGridSubsystem* PickupGrid = GetWorld()->GetSubsystem<UFGPickupGridSubsystem>())
+			PickupGrid->RegisterPickup(this);
+	}
+
+	if (HasAuthority() && NetDormancy > DORM_Awake)
+	{
+		INC_DWORD_STAT(STAT_FGNet_DormantActors);
+	}
 }
 
 void AFGPickup::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
 	Super::EndPlay(EndPlayReason);
 
-	if (const UWorld* World = GetWorld())
+	if (UWorld* World = GetWorld())
 	{
 		World->GetTimerManager().ClearTimer(ReActivateHandle);
+
+		if (UFGPickupAnimationSubsystem* PickupAnimation = World->GetSubsystem<UFGPickupAnimationSubsystem>())
+			PickupAnimation->UnregisterPickup(this);
+
+		if (UFGPickupGridSubsystem* PickupGrid = World->GetSubsystem<UFGPickupGridSubsystem>())
+			PickupGrid->UnregisterPickup(this);
+	}
+
+	if (HasAuthority() && NetDormancy > DORM_Awake)
+	{
+		DEC_DWORD_STAT(STAT_FGNet_DormantActors);
 	}
 }
 
-void AFGPickup::Tick(float DeltaTime)
+void AFGPickup::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(AFGPickup, bPickedUp);
+}
+
+FVector AFGPickup::GetPickupLocation() const
 {
-	Super::Tick(DeltaTime);
+	return SphereComponent->GetComponentLocation();
+}
 
-	const float PulsatingValue = FMath::MakePulsatingValue(GetWorld()->GetTimeSeconds(), 0.65f) * 30.0f;
-	const FVector NewLocation = CachedMeshRelativeLocation + FVector(0, 0, PulsatingValue);
+float AFGPickup::GetPickupRadius() const
+{
+	return SphereComponent->GetScaledSphereRadius();
+}
 
-	FHitResult Hit;
-	MeshComponent->SetRelativeLocation(NewLocation, false, &Hit, ETeleportType::TeleportPhysics);
-	MeshComponent->SetRelativeRotation(FRotator(0, 20.0f * DeltaTime, 0), false, &Hit, ETeleportType::TeleportPhysics);
+void AFGPickup::Collect(AFGPlayer* Player)
+{
+	if (bPickedUp || !HasAuthority())
+		return;
+
+	FGNET_INC_COUNTER(PickupsCollected);
+	Player->OnPickup(this);
+	bPickedUp = true;
+	SetPickupVisibility(false);
+	GetWorldTimerManager().SetTimer(ReActivateHandle, this, &AFGPickup::ReActivatePickup, ReActivateTime, false);
+	FlushPickedUp();
 }
 
 void AFGPickup::ReActivatePickup()
 {
 	bPickedUp = false;
+	SetPickupVisibility(true);
 
-	RootComponent->SetVisibility(true, true);
-	SphereComponent->SetCollisionProfileName(TEXT("OverlapAllDynamic"));
-	SetActorTickEnabled(true);
+	FlushPickedUp();
 }
 
-void AFGPickup::OverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+void AFGPickup::OnRep_PickedUp()
 {
-	if (bPickedUp)
-	{
+	SetPickupVisibility(!bPickedUp);
+}
+
+void AFGPickup::SetPickupVisibility(bool bVisible)
+{
+	RootComponent->SetVisibility(bVisible, true);
+}
+
+void AFGPickup::FlushPickedUp()
+{
+	if (!HasAuthority())
 		return;
-	}
 
-	if (AFGPlayer* Player = Cast<AFGPlayer>(OtherActor))
-	{
-		Player->OnPickup(this);
-		bPickedUp = true;
-		SphereComponent->SetCollisionProfileName(TEXT("NoCollision"));
-		RootComponent->SetVisibility(false, true);
-		GetWorldTimerManager().SetTimer(ReActivateHandle, this, &AFGPickup::ReActivatePickup, ReActivateTime, false);
-		SetActorTickEnabled(false);
-	}
+	// Also turns DORM_Initial into DORM_DormantAll, so the change reaches clients that loaded the pickup with the map.
+	FlushNetDormancy();
+	INC_DWORD_STAT(STAT_FGNet_DormancyWakes);
 }
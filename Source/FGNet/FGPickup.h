@@ -5,6 +5,7 @@
 
 class USphereComponent;
 class UStaticMeshComponent;
+class AFGPlayer;
 
 UENUM(BlueprintType)
 enum class EFGPickupType : uint8
@@ -23,8 +24,7 @@ public:
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
-	virtual void Tick(float DeltaTime) override;
-
+	// Only defines the pickup radius, collection is done by UFGPickupGridSubsystem without physics.
 	UPROPERTY(VisibleDefaultsOnly, Category = Collision)
 		USphereComponent* SphereComponent;
 
@@ -40,6 +40,17 @@ public:
 	UPROPERTY(EditAnywhere)
 		float ReActivateTime = 5.0f;
 
+	bool IsPickedUp() const { return bPickedUp; }
+
+	// Center and scaled radius of the sphere component, which may be placed off the root.
+	FVector GetPickupLocation() const;
+	float GetPickupRadius() const;
+
+	// Hands the pickup to Player and hides it until it respawns. Server only, called by UFGPickupGridSubsystem.
+	void Collect(AFGPlayer* Player);
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
 private:
 	FVector CachedMeshRelativeLocation = FVector::ZeroVector;
 	FTimerHandle ReActivateHandle;
@@ -47,8 +58,19 @@ private:
 	UFUNCTION()
 		void ReActivatePickup();
 
+	// Pickups stay dormant for good, changes to bPickedUp are sent by flushing the dormancy once.
+	void FlushPickedUp();
+
 	UFUNCTION()
-		void OverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+		void OnRep_PickedUp();
+
+	void SetPickupVisibility(bool bVisible);
+
+	UPROPERTY(ReplicatedUsing = OnRep_PickedUp)
+		bool bPickedUp = false;
+
+	friend class UFGPickupAnimationSubsystem;
 
-	bool bPickedUp = false;
+	// Slot in the pickup animation subsystem, INDEX_NONE on dedicated servers.
+	int32 AnimationIndex = INDEX_NONE;
 };
\ No newline at end of file
@@ -1,10 +1,22 @@
 #include "FGRocket.h"
 #include "Components/StaticMeshComponent.h"
 #include "Engine/World.h"
-#include "Kismet/GameplayStatics.h"
 #include "DrawDebugHelpers.h"
 #include "Player/FGPlayer.h"
+#include "FGNetStats.h"
+#include "HAL/IConsoleManager.h"
+#include "Debug/FGCorrectionTelemetry.h"
+#include "Subsystems/FGExplosionPoolSubsystem.h"
+#include "Subsystems/FGLagCompensationSubsystem.h"
+#include "Subsystems/FGRocketPoolSubsystem.h"
+#include "Subsystems/FGRocketRenderSubsystem.h"
+#include "Subsystems/FGRocketSimulationSubsystem.h"
 
+static TAutoConsoleVariable<int32> CVarDebugDrawRocketCorrection(
+	TEXT("FGNet.DebugDrawRocketCorrection"),
+	0,
+	TEXT("1: Moving rockets draw the direction they were fired in and the direction they're flying in."),
+	ECVF_Cheat);
 
 AFGRocket::AFGRocket()
 {
@@ -17,79 +29,187 @@ AFGRocket::AFGRocket()
 	MeshComponent->SetupAttachment(RootComponent);
 	MeshComponent->SetGenerateOverlapEvents(false);
 	MeshComponent->SetCollisionProfileName(TEXT("NoCollision"));
+	MeshComponent->bAutoRegister = false;
 
-	SetReplicates(true);
+	// Every machine pools and simulates its own rockets, shots are replicated by the players that fire them.
+	SetReplicates(false);
 }
 
 void AFGRocket::BeginPlay()
 {
 	Super::BeginPlay();
 
-	CachedCollisionQueryParams.AddIgnoredActor(this);
-	// Owner will be the player that instantiated this.
-	CachedCollisionQueryParams.AddIgnoredActor(GetOwner());
-
 	SetRocketVisibility(false);
+
+	if (UFGRocketPoolSubsystem* RocketPool = GetWorld()->GetSubsystem<UFGRocketPoolSubsystem>())
+	{
+		RocketPool->RegisterRocket(this);
+	}
+
+	if (UFGExplosionPoolSubsystem* ExplosionPool = GetWorld()->GetSubsystem<UFGExplosionPoolSubsystem>())
+	{
+		ExplosionPool->Prewarm(Explosion);
+	}
+
+	if (GetWorld()->GetNetMode() != NM_Client)
+	{
+		LagCompensation = GetWorld()->GetSubsystem<UFGLagCompensationSubsystem>();
+	}
 }
 
-void AFGRocket::Tick(float DeltaTime)
+void AFGRocket::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::Tick(DeltaTime);
+	Super::EndPlay(EndPlayReason);
 
-	LifeTimeElapsed -= DeltaTime;
-	DistanceMoved += MovementVelocity * DeltaTime;
+	if (SimulationIndex != INDEX_NONE)
+	{
+		if (UFGRocketSimulationSubsystem* RocketSimulation = GetWorld()->GetSubsystem<UFGRocketSimulationSubsystem>())
+			RocketSimulation->RemoveRocket(this);
+	}
 
-	FacingRotationStart = FQuat::Slerp(FacingRotationStart.ToOrientationQuat(), FacingRotationCorrection, 0.9f * DeltaTime).Vector();
+	SetRocketVisibility(false);
 
-#if !UE_BUILD_SHIPPING
-	if (bDebugDrawCorrection)
+	if (UFGRocketPoolSubsystem* RocketPool = GetWorld()->GetSubsystem<UFGRocketPoolSubsystem>())
 	{
-		const float ArrowLength = 3000.0f;
-		const float ArrowSize = 50.0f;
-		DrawDebugDirectionalArrow(GetWorld(), RocketStartLocation, RocketStartLocation + OriginalFacingDirection * ArrowLength, ArrowSize, FColor::Red);
-		DrawDebugDirectionalArrow(GetWorld(), RocketStartLocation, RocketStartLocation + FacingRotationStart * ArrowLength, ArrowSize, FColor::Green);
+		RocketPool->UnregisterRocket(this);
 	}
-#endif // !UE_BUILD_SHIPPING
+}
 
-	const FVector NewLocation = RocketStartLocation + FacingRotationStart * DistanceMoved;
+void AFGRocket::Tick(float DeltaTime)
+{
+	FGNET_SCOPE_CYCLE_COUNTER(RocketTick);
+
+	Super::Tick(DeltaTime);
+
+	const FVector NewLocation = Integrate(DeltaTime, MovementVelocity, RocketStartLocation, FacingRotationCorrection, FacingRotationStart, DistanceMoved, LifeTimeElapsed);
+
+	OnMoved(FacingRotationStart);
 
 	SetActorLocation(NewLocation);
+	SetRenderTransform(NewLocation, FacingRotationStart);
 
 	FHitResult Hit;
-	const FVector StartLoc = NewLocation;
-	const FVector EndLoc = StartLoc + FacingRotationStart * 100.0f;
-	GetWorld()->LineTraceSingleByChannel(Hit, StartLoc, EndLoc, ECC_Visibility, CachedCollisionQueryParams);
+	TraceHit(NewLocation, FacingRotationStart, Hit);
 
 	if (Hit.bBlockingHit)
 		ExplodeHit(Hit);
-
-	if (LifeTimeElapsed < 0.0f)
+	else if (LifeTimeElapsed < 0.0f)
 		Explode();
 }
 
+FVector AFGRocket::Integrate(float DeltaTime, float Velocity, const FVector& StartLocation, const FQuat& FacingCorrection, FVector& InOutFacing, float& InOutDistance, float& InOutLifeTimeLeft)
+{
+	InOutLifeTimeLeft -= DeltaTime;
+	InOutDistance += Velocity * DeltaTime;
+
+	InOutFacing = FQuat::Slerp(InOutFacing.ToOrientationQuat(), FacingCorrection, 0.9f * DeltaTime).Vector();
+
+	return StartLocation + InOutFacing * InOutDistance;
+}
+
+bool AFGRocket::TraceHit(const FVector& Location, const FVector& Facing, FHitResult& OutHit) const
+{
+	const FVector TraceEnd = Location + Facing * GetHitTraceLength();
+	GetWorld()->LineTraceSingleByChannel(OutHit, Location, TraceEnd, ECC_Visibility, CachedCollisionQueryParams);
+
+	if (LagCompensation == nullptr)
+		return OutHit.bBlockingHit;
+
+	// The server hits players where the shooter saw them when it fired, not where they are on the server now.
+	if (OutHit.bBlockingHit && Cast<AFGPlayer>(OutHit.GetActor()) != nullptr)
+	{
+		OutHit = FHitResult();
+	}
+
+	const float ViewTime = GetWorld()->GetTimeSeconds() - LagCompensationRewindTime;
+	FHitResult RewoundHit;
+	if (LagCompensation->TraceRewound(Location, TraceEnd, ViewTime, GetShooter(), RewoundHit) && (!OutHit.bBlockingHit || RewoundHit.Time < OutHit.Time))
+	{
+		// Explode and ApplyDamage only happen for blocking hits.
+		ensureMsgf(RewoundHit.bBlockingHit, TEXT("Rewound hit on %s isn't blocking."), *GetNameSafe(RewoundHit.GetActor()));
+		OutHit = RewoundHit;
+	}
+
+	return OutHit.bBlockingHit;
+}
+
+void AFGRocket::OnMoved(const FVector& CurrentFacing)
+{
+	if (CorrectionStartTime >= 0.0f && FVector::DotProduct(CurrentFacing, FacingRotationCorrection.GetForwardVector()) >= FMath::Cos(FMath::DegreesToRadians(FFGCorrectionTelemetry::RocketConvergedAngle)))
+	{
+		FFGCorrectionTelemetry::RocketConvergeTime.Add(GetWorld()->GetTimeSeconds() - CorrectionStartTime);
+		CorrectionStartTime = -1.0f;
+	}
+
+	DrawDebugCorrection(CurrentFacing);
+}
+
+void AFGRocket::DrawDebugCorrection(const FVector& CurrentFacing) const
+{
+#if !UE_BUILD_SHIPPING
+	if (CVarDebugDrawRocketCorrection.GetValueOnGameThread() != 0)
+	{
+		const float ArrowLength = 3000.0f;
+		const float ArrowSize = 50.0f;
+		DrawDebugDirectionalArrow(GetWorld(), RocketStartLocation, RocketStartLocation + OriginalFacingDirection * ArrowLength, ArrowSize, FColor::Red);
+		DrawDebugDirectionalArrow(GetWorld(), RocketStartLocation, RocketStartLocation + CurrentFacing * ArrowLength, ArrowSize, FColor::Green);
+	}
+#endif // !UE_BUILD_SHIPPING
+}
+
 void AFGRocket::StartMoving(const FVector& Forward, const FVector& InStartLocation)
 {
 	FacingRotationStart = Forward;
 	FacingRotationCorrection = FacingRotationStart.ToOrientationQuat();
 	RocketStartLocation = InStartLocation;
+
+	// The pool hands the rocket to a different player every time it's fired.
+	CachedCollisionQueryParams.ClearIgnoredActors();
+	CachedCollisionQueryParams.AddIgnoredActor(this);
+	CachedCollisionQueryParams.AddIgnoredActor(GetShooter());
+
 	SetActorLocationAndRotation(InStartLocation, Forward.Rotation());
 	bIsFree = false;
-	SetActorTickEnabled(true);
+	LaunchCount++;
+	CorrectionStartTime = -1.0f;
+	SetRenderTransform(InStartLocation, Forward);
 	SetRocketVisibility(true);
 	LifeTimeElapsed = LifeTime;
 	DistanceMoved = 0.0f;
 	OriginalFacingDirection = FacingRotationStart;
+
+	UFGRocketSimulationSubsystem* RocketSimulation = GetWorld()->GetSubsystem<UFGRocketSimulationSubsystem>();
+	if (RocketSimulation != nullptr && UFGRocketSimulationSubsystem::IsBatchingEnabled())
+	{
+		SetActorTickEnabled(false);
+		RocketSimulation->AddRocket(this);
+	}
+	else
+	{
+		if (RocketSimulation != nullptr)
+			RocketSimulation->RemoveRocket(this);
+		SetActorTickEnabled(true);
+	}
 }
 
 void AFGRocket::ApplyCorrection(const FVector& Forward)
 {
 	FacingRotationCorrection = Forward.ToOrientationQuat();
+
+	const float CorrectionAngle = FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(FVector::DotProduct(OriginalFacingDirection, Forward.GetSafeNormal()), -1.0f, 1.0f)));
+	FFGCorrectionTelemetry::RocketCorrectionAngle.Add(CorrectionAngle);
+	CorrectionStartTime = GetWorld()->GetTimeSeconds();
+
+	if (SimulationIndex != INDEX_NONE)
+	{
+		if (UFGRocketSimulationSubsystem* RocketSimulation = GetWorld()->GetSubsystem<UFGRocketSimulationSubsystem>())
+			RocketSimulation->SetFacingCorrection(this, FacingRotationCorrection);
+	}
 }
 
 void AFGRocket::ExplodeHit(FHitResult Hit)
 {
-	if (Explosion != nullptr)
-		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), Explosion, GetActorLocation(), GetActorRotation(), true);
+	PlayExplosion();
 	MakeFree();
 
 	if (AFGPlayer* Player = Cast<AFGPlayer>(Hit.Actor))
@@ -100,20 +220,51 @@ void AFGRocket::ExplodeHit(FHitResult Hit)
 
 void AFGRocket::Explode()
 {
-	if (Explosion != nullptr)
-		UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), Explosion, GetActorLocation(), GetActorRotation(), true);
+	PlayExplosion();
 	MakeFree();
 }
 
+void AFGRocket::PlayExplosion() const
+{
+	if (UFGExplosionPoolSubsystem* ExplosionPool = GetWorld()->GetSubsystem<UFGExplosionPoolSubsystem>())
+	{
+		ExplosionPool->PlayExplosion(Explosion, GetActorLocation(), GetActorRotation());
+	}
+}
+
 void AFGRocket::MakeFree()
 {
 	bIsFree = true;
 	SetActorTickEnabled(false);
+
+	if (SimulationIndex != INDEX_NONE)
+	{
+		if (UFGRocketSimulationSubsystem* RocketSimulation = GetWorld()->GetSubsystem<UFGRocketSimulationSubsystem>())
+			RocketSimulation->RemoveRocket(this);
+	}
+
 	SetRocketVisibility(false);
+
+	if (UFGRocketPoolSubsystem* RocketPool = GetWorld()->GetSubsystem<UFGRocketPoolSubsystem>())
+	{
+		RocketPool->ReleaseRocket(this);
+	}
 }
 
 void AFGRocket::SetRocketVisibility(bool bVisible)
 {
-	RootComponent->SetVisibility(bVisible, true);
+	UFGRocketRenderSubsystem* RocketRender = GetWorld()->GetSubsystem<UFGRocketRenderSubsystem>();
+	if (RocketRender == nullptr)
+		return;
+
+	if (bVisible)
+		RocketRender->AddRocket(this);
+	else
+		RocketRender->RemoveRocket(this);
 }
 
+void AFGRocket::SetRenderTransform(const FVector& Location, const FVector& Facing)
+{
+	RenderLocation = Location;
+	RenderFacing = Facing;
+}
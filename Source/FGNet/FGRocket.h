@@ -4,6 +4,7 @@
 #include "FGRocket.generated.h"
 
 class UStaticMeshComponent;
+class UFGLagCompensationSubsystem;
 
 UCLASS()
 class FGNET_API AFGRocket : public AActor
@@ -13,6 +14,7 @@ public:
 	AFGRocket();
 
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 	virtual void Tick(float DeltaSeconds) override;
 
@@ -21,13 +23,47 @@ public:
 
 	bool IsFree() const { return bIsFree; }
 
+	// Counts how often the rocket was fired, tells a pooled rocket's current shot from earlier ones.
+	uint32 GetLaunchCount() const { return LaunchCount; }
+
+	// Player that fired the rocket, as far as this machine's rocket pool knows.
+	AActor* GetShooter() const { return PoolOwner.Get(); }
+
 	void Explode();
 
 	void ExplodeHit(FHitResult Hit);
 
 	void MakeFree();
+
+	// Advances a rocket along its facing direction while turning it towards the correction from the server.
+	// Returns the new location. Shared by the per-actor tick and the batched rocket simulation.
+	static FVector Integrate(float DeltaTime, float Velocity, const FVector& StartLocation, const FQuat& FacingCorrection, FVector& InOutFacing, float& InOutDistance, float& InOutLifeTimeLeft);
+
+	// Traces ahead of the rocket. On the server players are tested where they were LagCompensationRewindTime ago.
+	bool TraceHit(const FVector& Location, const FVector& Facing, FHitResult& OutHit) const;
+
+	// How far the shooter's view of the other players was behind the server when the rocket was fired. Server only.
+	void SetLagCompensationRewindTime(float InRewindTime) { LagCompensationRewindTime = InRewindTime; }
+
+	// Called every time the rocket moved. Records how long a correction takes to converge and draws the original and
+	// the current direction when FGNet.DebugDrawRocketCorrection is set.
+	void OnMoved(const FVector& CurrentFacing);
+
+	const FCollisionQueryParams& GetCollisionQueryParams() const { return CachedCollisionQueryParams; }
+	// Never registered, rockets are drawn by UFGRocketRenderSubsystem which copies the mesh and materials from it.
+	const UStaticMeshComponent* GetMeshComponent() const { return MeshComponent; }
+	const FVector& GetStartLocation() const { return RocketStartLocation; }
+	float GetMovementVelocity() const { return MovementVelocity; }
+	float GetLifeTime() const { return LifeTime; }
+
+	// Length of the trace in front of the rocket that decides if it hit something.
+	static float GetHitTraceLength() { return 100.0f; }
 private:
 	void SetRocketVisibility(bool bVisible);
+	void PlayExplosion() const;
+
+	// Where the rocket is drawn, written by whoever moves it without touching the actor's transform.
+	void SetRenderTransform(const FVector& Location, const FVector& Facing);
 
 	FCollisionQueryParams CachedCollisionQueryParams;
 
@@ -37,11 +73,13 @@ private:
 	UPROPERTY(VisibleDefaultsOnly, Category = Mesh)
 		UStaticMeshComponent* MeshComponent = nullptr;
 
-	UPROPERTY(EditAnywhere, Category = Debug)
-		bool bDebugDrawCorrection = true;
+	void DrawDebugCorrection(const FVector& CurrentFacing) const;
 
 	FVector OriginalFacingDirection = FVector::ZeroVector;
 
+	// World time the last correction was applied, negative once the rocket turned to it or without a correction.
+	float CorrectionStartTime = -1.0f;
+
 	FVector FacingRotationStart = FVector::ZeroVector;
 	FQuat FacingRotationCorrection = FQuat::Identity;
 
@@ -56,4 +94,27 @@ private:
 		float MovementVelocity = 1300.0f;
 
 	bool bIsFree = true;
+	uint32 LaunchCount = 0;
+
+	UPROPERTY(Transient)
+		UFGLagCompensationSubsystem* LagCompensation = nullptr;
+
+	float LagCompensationRewindTime = 0.0f;
+
+	friend class UFGRocketPoolSubsystem;
+	friend class UFGRocketSimulationSubsystem;
+	friend class UFGRocketRenderSubsystem;
+
+	FVector RenderLocation = FVector::ZeroVector;
+	FVector RenderFacing = FVector::ForwardVector;
+
+	// Instance in the rocket render subsystem while the rocket is drawn.
+	int32 RenderIndex = INDEX_NONE;
+
+	// Slot in the batched rocket simulation while it's moving, INDEX_NONE when the rocket ticks itself or is free.
+	int32 SimulationIndex = INDEX_NONE;
+
+	int32 PoolIndex = INDEX_NONE;
+	int32 FreeListIndex = INDEX_NONE;
+	TWeakObjectPtr<AActor> PoolOwner;
 };
\ No newline at end of file
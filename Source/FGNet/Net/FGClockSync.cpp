@@ -0,0 +1,101 @@
+#include "FGClockSync.h"
+
+void FFGClockSync::Initialize(int32 InNumOffsetSamples)
+{
+	NumOffsetSamples = FMath::Max(InNumOffsetSamples, 1);
+	Reset();
+}
+
+void FFGClockSync::Reset()
+{
+	PendingPings.Reset();
+	OffsetSamples.Reset();
+	NextOffsetSample = 0;
+	NumPongs = 0;
+	RoundTripTime = 0.0f;
+	LastRoundTripTime = 0.0f;
+	Jitter = 0.0f;
+	LossRate = 0.0f;
+	ServerTimeOffset = 0.0f;
+}
+
+uint8 FFGClockSync::SendPing(double RealTime, float WorldTime)
+{
+	FPendingPing& Ping = PendingPings.AddDefaulted_GetRef();
+	Ping.Id = NextPingId++;
+	Ping.RealSendTime = RealTime;
+	Ping.WorldSendTime = WorldTime;
+	return Ping.Id;
+}
+
+void FFGClockSync::ReceivePong(uint8 PingId, float ServerTime, double RealTime, float WorldTime)
+{
+	const int32 Index = PendingPings.IndexOfByPredicate([PingId](const FPendingPing& Ping) { return Ping.Id == PingId; });
+	if (Index == INDEX_NONE)
+		return;
+
+	const FPendingPing Ping = PendingPings[Index];
+	PendingPings.RemoveAt(Index, 1, false);
+	UpdateLossRate(false);
+
+	const float SampleRoundTripTime = static_cast<float>(RealTime - Ping.RealSendTime);
+	if (NumPongs == 0)
+	{
+		RoundTripTime = SampleRoundTripTime;
+		Jitter = 0.0f;
+	}
+	else
+	{
+		RoundTripTime += (SampleRoundTripTime - RoundTripTime) / 8.0f;
+		Jitter += (FMath::Abs(SampleRoundTripTime - LastRoundTripTime) - Jitter) / 16.0f;
+	}
+	LastRoundTripTime = SampleRoundTripTime;
+
+	// The server stamped the pong about halfway between sending the ping and receiving the pong.
+	FOffsetSample Sample;
+	Sample.RoundTripTime = SampleRoundTripTime;
+	Sample.Offset = ServerTime - (Ping.WorldSendTime + WorldTime) * 0.5f;
+	if (OffsetSamples.Num() < NumOffsetSamples)
+	{
+		OffsetSamples.Add(Sample);
+	}
+	else
+	{
+		OffsetSamples[NextOffsetSample] = Sample;
+	}
+	NextOffsetSample = (NextOffsetSample + 1) % NumOffsetSamples;
+
+	const FOffsetSample* BestSample = &OffsetSamples[0];
+	for (const FOffsetSample& OffsetSample : OffsetSamples)
+	{
+		if (OffsetSample.RoundTripTime < BestSample->RoundTripTime)
+			BestSample = &OffsetSample;
+	}
+
+	// Large differences are a clock that was never synced or a hitch, those are taken over right away.
+	const float MaxBlendedError = 0.25f;
+	const float OffsetError = BestSample->Offset - ServerTimeOffset;
+	if (NumPongs == 0 || FMath::Abs(OffsetError) > MaxBlendedError)
+		ServerTimeOffset = BestSample->Offset;
+	else
+		ServerTimeOffset += OffsetError * 0.25f;
+
+	NumPongs++;
+}
+
+void FFGClockSync::ExpirePings(double RealTime, double Timeout)
+{
+	for (int32 Index = PendingPings.Num() - 1; Index >= 0; --Index)
+	{
+		if (RealTime - PendingPings[Index].RealSendTime > Timeout)
+		{
+			PendingPings.RemoveAt(Index, 1, false);
+			UpdateLossRate(true);
+		}
+	}
+}
+
+void FFGClockSync::UpdateLossRate(bool bLost)
+{
+	LossRate += ((bLost ? 1.0f : 0.0f) - LossRate) / 16.0f;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Client side of the clock sync. Every pong gives a round trip time, measured on the high resolution platform clock,
+// and a sample of the offset between this world's time and the server's. The round trip time is smoothed like TCP's
+// SRTT, jitter is the mean deviation between consecutive round trips (RFC 3550) and pings that time out count as lost.
+// The offset comes from the sample with the lowest round trip in the last few, it had the least queueing delay to
+// skew it, and is blended in so the server time never jumps by small amounts.
+struct FGNET_API FFGClockSync
+{
+	void Initialize(int32 InNumOffsetSamples);
+	void Reset();
+
+	// Returns the id to send with the ping.
+	uint8 SendPing(double RealTime, float WorldTime);
+
+	// Pongs of pings that already timed out are ignored.
+	void ReceivePong(uint8 PingId, float ServerTime, double RealTime, float WorldTime);
+
+	// Counts pings without pong for longer than Timeout as lost.
+	void ExpirePings(double RealTime, double Timeout);
+
+	bool IsSynchronized() const { return NumPongs > 0; }
+
+	// Seconds.
+	float GetRoundTripTime() const { return RoundTripTime; }
+	float GetJitter() const { return Jitter; }
+
+	// Fraction of the recent pings that were lost, 0 to 1.
+	float GetLossRate() const { return LossRate; }
+
+	float GetServerTimeOffset() const { return ServerTimeOffset; }
+	float GetServerTime(float WorldTime) const { return WorldTime + ServerTimeOffset; }
+
+	int32 GetNumPendingPings() const { return PendingPings.Num(); }
+
+private:
+	void UpdateLossRate(bool bLost);
+
+	struct FPendingPing
+	{
+		uint8 Id = 0;
+		double RealSendTime = 0.0;
+		float WorldSendTime = 0.0f;
+	};
+
+	struct FOffsetSample
+	{
+		float RoundTripTime = 0.0f;
+		float Offset = 0.0f;
+	};
+
+	TArray<FPendingPing> PendingPings;
+	TArray<FOffsetSample> OffsetSamples;
+	int32 NumOffsetSamples = 8;
+	int32 NextOffsetSample = 0;
+
+	uint8 NextPingId = 0;
+	int32 NumPongs = 0;
+
+	float RoundTripTime = 0.0f;
+	float LastRoundTripTime = 0.0f;
+	float Jitter = 0.0f;
+	float LossRate = 0.0f;
+	float ServerTimeOffset = 0.0f;
+};
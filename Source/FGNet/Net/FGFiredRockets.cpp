@@ -0,0 +1,95 @@
+#include "FGFiredRockets.h"
+#include "UObject/CoreNet.h"
+#include "HAL/IConsoleManager.h"
+#include "../FGNet.h"
+#include "../Player/FGPlayer.h"
+
+void FFGFiredRocket::PostReplicatedAdd(const FFGFiredRocketArray& InArraySerializer)
+{
+	if (InArraySerializer.Owner != nullptr)
+	{
+		InArraySerializer.Owner->OnRocketFired(*this);
+	}
+}
+
+FFGFiredRocket& FFGFiredRocketArray::Add(uint16 PredictedShotId, const FVector& StartLocation, float Yaw, float ServerTime)
+{
+	FFGFiredRocket& FiredRocket = Items.AddDefaulted_GetRef();
+	FiredRocket.ShotId = NextShotId++;
+	FiredRocket.PredictedShotId = PredictedShotId;
+	FiredRocket.StartLocation = StartLocation;
+	FiredRocket.CompressedYaw = FRotator::CompressAxisToShort(Yaw);
+	FiredRocket.ServerTime = ServerTime;
+	MarkItemDirty(FiredRocket);
+	return FiredRocket;
+}
+
+bool FFGFiredRocketArray::RemoveOlderThan(float ServerTime)
+{
+	// Shots are added in order, the oldest ones are at the front.
+	int32 NumToRemove = 0;
+	while (NumToRemove < Items.Num() && Items[NumToRemove].ServerTime < ServerTime)
+	{
+		NumToRemove++;
+	}
+
+	if (NumToRemove == 0)
+		return false;
+
+	Items.RemoveAt(0, NumToRemove, false);
+	MarkArrayDirty();
+	return true;
+}
+
+static void ReportFireRocketSize()
+{
+	const FVector StartLocation(8421.37f, -5123.91f, 112.15f);
+	const FRotator Rotation(0.0f, 137.52f, 0.0f);
+	const float Time = 1234.5f;
+	bool bSuccess = true;
+
+	// What Server_FireRocket and Multicast_FireRocket used to put on the wire. A mapped actor reference is a packed
+	// NetGUID, the first reference to an actor also exports its path.
+	FNetBitWriter OldServerWriter(nullptr, 1024);
+	FNetworkGUID RocketGUID = FNetworkGUID(4711);
+	FVector StartCopy = StartLocation;
+	FRotator RotationCopy = Rotation;
+	float TimeCopy = Time;
+	OldServerWriter << RocketGUID;
+	OldServerWriter << StartCopy;
+	RotationCopy.NetSerialize(OldServerWriter, nullptr, bSuccess);
+	OldServerWriter << TimeCopy;
+
+	FNetBitWriter OldMulticastWriter(nullptr, 1024);
+	FNetworkGUID PredictedRocketGUID = FNetworkGUID(4713);
+	OldMulticastWriter << RocketGUID;
+	OldMulticastWriter << PredictedRocketGUID;
+	OldMulticastWriter << StartCopy;
+	RotationCopy.NetSerialize(OldMulticastWriter, nullptr, bSuccess);
+
+	FNetBitWriter NewServerWriter(nullptr, 1024);
+	uint16 PredictedShotId = 42;
+	FVector_NetQuantize QuantizedStart = StartLocation;
+	uint16 CompressedYaw = FRotator::CompressAxisToShort(Rotation.Yaw);
+	NewServerWriter << PredictedShotId;
+	QuantizedStart.NetSerialize(NewServerWriter, nullptr, bSuccess);
+	NewServerWriter << CompressedYaw;
+	NewServerWriter << TimeCopy;
+
+	// Property values of a shot record, without the fast array's per item and per property headers.
+	FNetBitWriter RecordWriter(nullptr, 1024);
+	uint16 ShotId = 7;
+	RecordWriter << ShotId;
+	RecordWriter << PredictedShotId;
+	QuantizedStart.NetSerialize(RecordWriter, nullptr, bSuccess);
+	RecordWriter << CompressedYaw;
+	RecordWriter << TimeCopy;
+
+	UE_LOG(LogFGNet, Log, TEXT("Server_FireRocket: %lld bits payload with a rocket reference, %lld bits with a predicted shot id."), OldServerWriter.GetNumBits(), NewServerWriter.GetNumBits());
+	UE_LOG(LogFGNet, Log, TEXT("Multicast_FireRocket: %lld bits payload per connection, reliable. Shot record: %lld bits of properties per connection, delta replicated."), OldMulticastWriter.GetNumBits(), RecordWriter.GetNumBits());
+}
+
+static FAutoConsoleCommand ReportFireRocketSizeCommand(
+	TEXT("FGNet.ReportFireRocketSize"),
+	TEXT("Logs the number of bits a shot costs compared to the old rocket reference RPCs."),
+	FConsoleCommandDelegate::CreateStatic(&ReportFireRocketSize));
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/NetSerialization.h"
+#include "FGFiredRockets.generated.h"
+
+class AFGPlayer;
+
+// One shot fired by the server. Start is quantized to 1cm and the yaw compressed to 16 bits, rockets fly level.
+USTRUCT()
+struct FFGFiredRocket : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+public:
+	// Per player, counts every shot the server fired.
+	UPROPERTY()
+		uint16 ShotId = 0;
+
+	// Id the owning client predicted the shot with, zero if it didn't.
+	UPROPERTY()
+		uint16 PredictedShotId = 0;
+
+	UPROPERTY()
+		FVector_NetQuantize StartLocation = FVector::ZeroVector;
+
+	UPROPERTY()
+		uint16 CompressedYaw = 0;
+
+	// Server world time the shot was fired at.
+	UPROPERTY()
+		float ServerTime = 0.0f;
+
+	FRotator GetFacingRotation() const { return FRotator(0.0f, FRotator::DecompressAxisFromShort(CompressedYaw), 0.0f); }
+
+	void PostReplicatedAdd(const struct FFGFiredRocketArray& InArraySerializer);
+};
+
+// Shots of one player, delta replicated instead of sent as reliable RPCs. The server drops shots once they're older
+// than the record lifetime, a client that didn't receive one by then never sees it.
+USTRUCT()
+struct FFGFiredRocketArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+public:
+	UPROPERTY()
+		TArray<FFGFiredRocket> Items;
+
+	UPROPERTY(NotReplicated)
+		AFGPlayer* Owner = nullptr;
+
+	FFGFiredRocket& Add(uint16 PredictedShotId, const FVector& StartLocation, float Yaw, float ServerTime);
+
+	// Returns true if any shot was removed.
+	bool RemoveOlderThan(float ServerTime);
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FFGFiredRocket, FFGFiredRocketArray>(Items, DeltaParms, *this);
+	}
+
+private:
+	uint16 NextShotId = 0;
+};
+
+template<>
+struct TStructOpsTypeTraits<FFGFiredRocketArray> : public TStructOpsTypeTraitsBase2<FFGFiredRocketArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true
+	};
+};
@@ -0,0 +1,70 @@
+#include "FGMovementValidator.h"
+#include "FGNetMovementState.h"
+#include "../Player/FGPlayerSettings.h"
+
+void FFGMovementValidator::Initialize(const UFGPlayerSettings* InSettings)
+{
+	Settings = InSettings;
+}
+
+void FFGMovementValidator::Reset(const FVector& InLocation, float CurrentTime)
+{
+	Location = InLocation;
+	Speed = 0.0f;
+	DistanceBudget = 0.0f;
+	LastTime = CurrentTime;
+}
+
+EFGMovementValidation FFGMovementValidator::Validate(FFGNetMovementState& InOutState, float CurrentTime)
+{
+	if (Settings == nullptr)
+		return EFGMovementValidation::Accepted;
+
+	const float MaxVelocity = Settings->MaxVelocity;
+	const float ElapsedTime = FMath::Clamp(CurrentTime - LastTime, 0.0f, Settings->MaxMovementBudgetTime);
+	LastTime = CurrentTime;
+
+	// Distance covered speeding up from the last speed for the elapsed time, never faster than max velocity.
+	const float ReachableSpeed = FMath::Min(Speed + Settings->Acceleration * ElapsedTime, MaxVelocity);
+	DistanceBudget = FMath::Min(DistanceBudget + (Speed + ReachableSpeed) * 0.5f * ElapsedTime, MaxVelocity * Settings->MaxMovementBudgetTime);
+
+	const FVector Delta = InOutState.Location - Location;
+	const float Distance = FMath::Sqrt(FMath::Square(Delta.X) + FMath::Square(Delta.Y) + FMath::Square(FMath::Max(Delta.Z, 0.0f)));
+	const float AllowedDistance = DistanceBudget + Settings->MovementValidationTolerance;
+
+	if (Distance > AllowedDistance + Settings->MaxMovementClampDistance)
+	{
+		Reject(InOutState, Location, CurrentTime);
+		return EFGMovementValidation::Rejected;
+	}
+
+	EFGMovementValidation Result = EFGMovementValidation::Accepted;
+	if (Distance > AllowedDistance)
+	{
+		const float Scale = AllowedDistance / Distance;
+		InOutState.Location = Location + FVector(Delta.X * Scale, Delta.Y * Scale, Delta.Z > 0.0f ? Delta.Z * Scale : Delta.Z);
+		Result = EFGMovementValidation::Clamped;
+	}
+
+	DistanceBudget = FMath::Max(DistanceBudget - FMath::Min(Distance, AllowedDistance), 0.0f);
+	InOutState.MovementVelocity = FMath::Clamp(InOutState.MovementVelocity, -ReachableSpeed, ReachableSpeed);
+	Speed = FMath::Abs(InOutState.MovementVelocity);
+	Location = InOutState.Location;
+	return Result;
+}
+
+void FFGMovementValidator::Reject(FFGNetMovementState& InOutState, const FVector& ValidLocation, float CurrentTime)
+{
+	Reset(ValidLocation, CurrentTime);
+	InOutState.Location = ValidLocation;
+	InOutState.MovementVelocity = 0.0f;
+}
+
+bool FFGMovementValidator::IsSweepDue(float CurrentTime)
+{
+	if (Settings == nullptr || CurrentTime - LastSweepTime < Settings->MovementSweepInterval)
+		return false;
+
+	LastSweepTime = CurrentTime;
+	return true;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UFGPlayerSettings;
+struct FFGNetMovementState;
+
+enum class EFGMovementValidation : uint8
+{
+	Accepted,
+	// Moved further than possible but not by much, the location was pulled back onto the reachable envelope.
+	Clamped,
+	// Moved impossibly far, the location was reset to the last valid one and the velocity to zero.
+	Rejected
+};
+
+// Server side check of the movement states a client sends, without simulating the move again. Between two states a
+// player can't have sped up faster than its acceleration or moved faster than its max velocity, so the distance
+// it can have covered is bounded by the elapsed time. States arrive with jitter and in bursts, so distance that wasn't
+// used is saved up for a while instead of judging every update on its own. Falling isn't bounded, only moving
+// horizontally and upwards.
+struct FGNET_API FFGMovementValidator
+{
+	void Initialize(const UFGPlayerSettings* InSettings);
+
+	// Trusts Location as valid, e.g. after spawning or a correction.
+	void Reset(const FVector& InLocation, float CurrentTime);
+
+	// Fixes the location and velocity of InOutState when it fails.
+	EFGMovementValidation Validate(FFGNetMovementState& InOutState, float CurrentTime);
+
+	// Rejects the last validated state after all, when a sweep found it went through something.
+	void Reject(FFGNetMovementState& InOutState, const FVector& ValidLocation, float CurrentTime);
+
+	// True every MovementSweepInterval, the caller then sweeps from the previous valid location to the new one.
+	bool IsSweepDue(float CurrentTime);
+
+	const FVector& GetLocation() const { return Location; }
+
+private:
+	const UFGPlayerSettings* Settings = nullptr;
+
+	FVector Location = FVector::ZeroVector;
+	float Speed = 0.0f;
+	float DistanceBudget = 0.0f;
+	float LastTime = 0.0f;
+	float LastSweepTime = 0.0f;
+};
@@ -0,0 +1,74 @@
+#include "FGNetConditionProfile.h"
+#include "Engine/NetDriver.h"
+
+FFGNetConditions FFGNetConditions::Combine(const FFGNetConditions& Other) const
+{
+	auto CombineBandwidth = [](int32 A, int32 B)
+	{
+		return A > 0 && B > 0 ? FMath::Min(A, B) : FMath::Max(A, B);
+	};
+
+	FFGNetConditions Result;
+	Result.UpLatency = UpLatency + Other.UpLatency;
+	Result.UpJitter = UpJitter + Other.UpJitter;
+	Result.UpLoss = FMath::Min(UpLoss + Other.UpLoss, 100);
+	Result.UpDuplication = FMath::Min(UpDuplication + Other.UpDuplication, 100);
+	Result.bUpReorder = bUpReorder || Other.bUpReorder;
+	Result.UpBandwidth = CombineBandwidth(UpBandwidth, Other.UpBandwidth);
+	Result.DownLatency = DownLatency + Other.DownLatency;
+	Result.DownJitter = DownJitter + Other.DownJitter;
+	Result.DownLoss = FMath::Min(DownLoss + Other.DownLoss, 100);
+	Result.DownBandwidth = CombineBandwidth(DownBandwidth, Other.DownBandwidth);
+	return Result;
+}
+
+void FFGNetConditions::ToPacketSimulationSettings(FPacketSimulationSettings& OutSettings) const
+{
+	// The packet simulation picks a random lag between min and max, which is the jitter.
+	OutSettings.PktLag = 0;
+	OutSettings.PktLagMin = UpLatency;
+	OutSettings.PktLagMax = UpLatency + UpJitter;
+	OutSettings.PktLoss = UpLoss;
+	OutSettings.PktDup = UpDuplication;
+	OutSettings.PktOrder = bUpReorder ? 1 : 0;
+	OutSettings.PktIncomingLagMin = DownLatency;
+	OutSettings.PktIncomingLagMax = DownLatency + DownJitter;
+	OutSettings.PktIncomingLoss = DownLoss;
+}
+
+bool FFGNetConditions::operator==(const FFGNetConditions& Other) const
+{
+	return UpLatency == Other.UpLatency
+		&& UpJitter == Other.UpJitter
+		&& UpLoss == Other.UpLoss
+		&& UpDuplication == Other.UpDuplication
+		&& bUpReorder == Other.bUpReorder
+		&& UpBandwidth == Other.UpBandwidth
+		&& DownLatency == Other.DownLatency
+		&& DownJitter == Other.DownJitter
+		&& DownLoss == Other.DownLoss
+		&& DownBandwidth == Other.DownBandwidth;
+}
+
+bool FFGNetConditionEvent::IsActive(float Time) const
+{
+	if (Time < StartTime)
+		return false;
+
+	const float TimeInEvent = Period > 0.0f ? FMath::Fmod(Time - StartTime, Period) : Time - StartTime;
+	return TimeInEvent < Duration;
+}
+
+FFGNetConditions FFGNetConditionProfileData::GetConditionsAtTime(float Time) const
+{
+	FFGNetConditions Conditions = Base;
+	for (const FFGNetConditionEvent& Event : Timeline)
+	{
+		if (Event.IsActive(Time))
+		{
+			Conditions = Conditions.Combine(Event.Conditions);
+		}
+	}
+
+	return Conditions;
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "Engine/DataAsset.h"
+#include "FGNetConditionProfile.generated.h"
+
+struct FPacketSimulationSettings;
+
+// Simulated network conditions. Up is traffic sent by this machine, down is traffic it receives.
+USTRUCT(BlueprintType)
+struct FGNET_API FFGNetConditions
+{
+	GENERATED_BODY()
+public:
+	// Milliseconds.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Up, meta = (ClampMin = 0))
+		int32 UpLatency = 0;
+
+	// Random extra milliseconds on top of UpLatency.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Up, meta = (ClampMin = 0))
+		int32 UpJitter = 0;
+
+	// Percent.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Up, meta = (ClampMin = 0, ClampMax = 100))
+		int32 UpLoss = 0;
+
+	// Percent of sent packets that are sent twice.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Up, meta = (ClampMin = 0, ClampMax = 100))
+		int32 UpDuplication = 0;
+
+	// Sent packets may overtake each other.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Up)
+		bool bUpReorder = false;
+
+	// Bytes per second, 0 is unlimited.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Up, meta = (ClampMin = 0))
+		int32 UpBandwidth = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Down, meta = (ClampMin = 0))
+		int32 DownLatency = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Down, meta = (ClampMin = 0))
+		int32 DownJitter = 0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Down, meta = (ClampMin = 0, ClampMax = 100))
+		int32 DownLoss = 0;
+
+	// Bytes per second, 0 is unlimited. Enforced by the sender, a client asks the server to send slower.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Down, meta = (ClampMin = 0))
+		int32 DownBandwidth = 0;
+
+	// Adds latency, jitter, loss and duplication, reordering is turned on by either side and the lower bandwidth
+	// cap wins.
+	FFGNetConditions Combine(const FFGNetConditions& Other) const;
+
+	void ToPacketSimulationSettings(FPacketSimulationSettings& OutSettings) const;
+
+	bool operator==(const FFGNetConditions& Other) const;
+	bool operator!=(const FFGNetConditions& Other) const { return !(*this == Other); }
+};
+
+// Conditions combined with the base conditions of a profile while the event is running.
+USTRUCT(BlueprintType)
+struct FGNET_API FFGNetConditionEvent
+{
+	GENERATED_BODY()
+public:
+	// Seconds after the profile is applied.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Timeline, meta = (ClampMin = 0.0))
+		float StartTime = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Timeline, meta = (ClampMin = 0.0))
+		float Duration = 0.0f;
+
+	// The event repeats this often, 0 runs it once.
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Timeline, meta = (ClampMin = 0.0))
+		float Period = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Timeline)
+		FFGNetConditions Conditions;
+
+	bool IsActive(float Time) const;
+};
+
+USTRUCT(BlueprintType)
+struct FGNET_API FFGNetConditionProfileData
+{
+	GENERATED_BODY()
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Profile)
+		FName Name;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Profile)
+		FFGNetConditions Base;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = Profile)
+		TArray<FFGNetConditionEvent> Timeline;
+
+	FFGNetConditions GetConditionsAtTime(float Time) const;
+};
+
+// Network condition profile authored as an asset. Profiles can also be listed in the config of
+// UFGNetConditionSubsystem, both are selected with -FGNetProfile=<name or asset path>.
+UCLASS(BlueprintType)
+class FGNET_API UFGNetConditionProfile : public UDataAsset
+{
+	GENERATED_BODY()
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Profile)
+		FFGNetConditionProfileData Profile;
+};
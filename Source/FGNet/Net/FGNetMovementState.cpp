@@ -0,0 +1,74 @@
+#include "FGNetMovementState.h"
+#include "Engine/NetSerialization.h"
+#include "UObject/CoreNet.h"
+#include "HAL/IConsoleManager.h"
+#include "../FGNet.h"
+
+bool FFGNetMovementState::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+{
+	bOutSuccess = SerializePackedVector<1, 24>(Location, Ar);
+
+	uint16 CompressedYaw = FRotator::CompressAxisToShort(Yaw);
+	Ar << CompressedYaw;
+
+	int16 QuantizedVelocity = static_cast<int16>(FMath::Clamp(FMath::RoundToInt(MovementVelocity), -MAX_int16, static_cast<int32>(MAX_int16)));
+	Ar << QuantizedVelocity;
+
+	Ar << Sequence;
+
+	// Only states sent by the server carry a time stamp.
+	uint8 bHasTimeStamp = TimeStamp > 0.0f ? 1 : 0;
+	Ar.SerializeBits(&bHasTimeStamp, 1);
+	if (bHasTimeStamp)
+	{
+		Ar << TimeStamp;
+	}
+
+	if (Ar.IsLoading())
+	{
+		Yaw = FRotator::DecompressAxisFromShort(CompressedYaw);
+		MovementVelocity = static_cast<float>(QuantizedVelocity);
+	}
+
+	return true;
+}
+
+static void ReportMovementStateSize()
+{
+	const FVector Location(8421.37f, -5123.91f, 112.15f);
+	const FRotator Rotation(0.0f, 137.52f, 0.0f);
+
+	// What Server_SendLocation and Server_SendRotation used to put on the wire.
+	FNetBitWriter LocationWriter(nullptr, 1024);
+	FVector LocationCopy = Location;
+	LocationWriter << LocationCopy;
+
+	FNetBitWriter RotationWriter(nullptr, 1024);
+	bool bSuccess = true;
+	FRotator RotationCopy = Rotation;
+	RotationCopy.NetSerialize(RotationWriter, nullptr, bSuccess);
+
+	FNetBitWriter StateWriter(nullptr, 1024);
+	FFGNetMovementState State;
+	State.Location = Location;
+	State.Yaw = Rotation.Yaw;
+	State.MovementVelocity = 1843.0f;
+	State.Sequence = 4711;
+	State.NetSerialize(StateWriter, nullptr, bSuccess);
+
+	FNetBitWriter StampedStateWriter(nullptr, 1024);
+	State.TimeStamp = 1234.5f;
+	State.NetSerialize(StampedStateWriter, nullptr, bSuccess);
+
+	const int64 OldBits = LocationWriter.GetNumBits() + RotationWriter.GetNumBits();
+	const int64 NewBits = StateWriter.GetNumBits();
+
+	UE_LOG(LogFGNet, Log, TEXT("Location + Rotation RPCs: %lld + %lld = %lld bits payload, 2 RPC headers per update (x2 with the multicast)."), LocationWriter.GetNumBits(), RotationWriter.GetNumBits(), OldBits);
+	UE_LOG(LogFGNet, Log, TEXT("Movement state RPC: %lld bits payload including velocity and sequence, 1 RPC header per update (x2 with the multicast)."), NewBits);
+	UE_LOG(LogFGNet, Log, TEXT("Time stamped server to client movement state: %lld bits payload."), StampedStateWriter.GetNumBits());
+}
+
+static FAutoConsoleCommand ReportMovementStateSizeCommand(
+	TEXT("FGNet.ReportMovementStateSize"),
+	TEXT("Logs the number of bits a movement update costs compared to the old separate location and rotation RPCs."),
+	FConsoleCommandDelegate::CreateStatic(&ReportMovementStateSize));
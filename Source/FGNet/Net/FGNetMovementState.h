@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FGNetMovementState.generated.h"
+
+// Movement state of a player packed into a single RPC parameter.
+// Location is quantized to 1cm, yaw is compressed to 16 bits and the velocity along the facing direction to whole cm/s.
+USTRUCT()
+struct FFGNetMovementState
+{
+	GENERATED_BODY()
+public:
+	FVector Location = FVector::ZeroVector;
+	float Yaw = 0.0f;
+	float MovementVelocity = 0.0f;
+
+	// Server world time the state is valid at, zero while it is travelling from the owning client to the server.
+	float TimeStamp = 0.0f;
+
+	// Lower 16 bits of the sender's sequence, used to drop stale states and to match acknowledged moves.
+	uint16 Sequence = 0;
+
+	FRotator GetRotation() const { return FRotator(0.0f, Yaw, 0.0f); }
+	FVector GetVelocity() const { return GetRotation().Vector() * MovementVelocity; }
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	// Returns true if InSequence is newer than LastSequence, taking wrap around into account.
+	static bool IsNewerSequence(uint16 InSequence, uint16 LastSequence)
+	{
+		return static_cast<int16>(InSequence - LastSequence) > 0;
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FFGNetMovementState> : public TStructOpsTypeTraitsBase2<FFGNetMovementState>
+{
+	enum
+	{
+		WithNetSerializer = true
+	};
+};
@@ -0,0 +1,60 @@
+#include "FGNetSendPolicy.h"
+#include "Engine/NetConnection.h"
+#include "../Player/FGPlayerSettings.h"
+
+void FFGNetSendPolicy::Initialize(const UFGPlayerSettings* InSettings)
+{
+	Settings = InSettings;
+	SendRate = Settings != nullptr ? Settings->MaxSendRate : 0.0f;
+}
+
+void FFGNetSendPolicy::UpdateCongestion(const UNetConnection* Connection, float CurrentTime)
+{
+	if (Settings == nullptr || Connection == nullptr)
+		return;
+
+	// IsNetReady isn't const but doesn't modify the connection.
+	if (!const_cast<UNetConnection*>(Connection)->IsNetReady(false))
+		bSaturatedSinceLastSample = true;
+
+	const float SampleDuration = CurrentTime - LastSampleTime;
+	if (SampleDuration < Settings->CongestionSampleInterval)
+		return;
+
+	const uint32 NumPackets = Connection->OutTotalPackets - LastOutTotalPackets;
+	const uint32 NumPacketsLost = Connection->OutTotalPacketsLost - LastOutTotalPacketsLost;
+	MeasuredLoss = NumPackets > 0 ? static_cast<float>(NumPacketsLost) / static_cast<float>(NumPackets) : 0.0f;
+
+	if (bSaturatedSinceLastSample || MeasuredLoss > Settings->CongestionLossThreshold)
+	{
+		SendRate *= Settings->SendRateBackoffFactor;
+	}
+	else
+	{
+		SendRate += Settings->SendRateRecovery * SampleDuration;
+	}
+
+	SendRate = FMath::Clamp(SendRate, Settings->MinSendRate, Settings->MaxSendRate);
+
+	LastOutTotalPackets = Connection->OutTotalPackets;
+	LastOutTotalPacketsLost = Connection->OutTotalPacketsLost;
+	LastSampleTime = CurrentTime;
+	bSaturatedSinceLastSample = false;
+}
+
+bool FFGNetSendPolicy::ShouldSend(float CurrentTime, bool bHasChanged) const
+{
+	if (Settings == nullptr)
+		return true;
+
+	const float TimeSinceLastSend = CurrentTime - LastSendTime;
+	if (TimeSinceLastSend < 1.0f / FMath::Max(SendRate, KINDA_SMALL_NUMBER))
+		return false;
+
+	return bHasChanged || TimeSinceLastSend >= Settings->IdleHeartbeatInterval;
+}
+
+void FFGNetSendPolicy::OnSent(float CurrentTime)
+{
+	LastSendTime = CurrentTime;
+}
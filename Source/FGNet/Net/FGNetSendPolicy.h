@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UNetConnection;
+class UFGPlayerSettings;
+
+// Decides when a movement update is worth sending. Updates are capped to a maximum rate, skipped while nothing
+// changes except for a heartbeat, and the rate backs off multiplicatively when the connection loses packets or
+// saturates and recovers additively when it does not (AIMD).
+struct FGNET_API FFGNetSendPolicy
+{
+	void Initialize(const UFGPlayerSettings* InSettings);
+
+	// Samples packet loss and saturation of the connection, call once per frame before ShouldSend.
+	void UpdateCongestion(const UNetConnection* Connection, float CurrentTime);
+
+	bool ShouldSend(float CurrentTime, bool bHasChanged) const;
+	void OnSent(float CurrentTime);
+
+	float GetSendRate() const { return SendRate; }
+	float GetMeasuredLoss() const { return MeasuredLoss; }
+
+private:
+	const UFGPlayerSettings* Settings = nullptr;
+
+	float SendRate = 0.0f;
+	float LastSendTime = -BIG_NUMBER;
+	float LastSampleTime = 0.0f;
+	float MeasuredLoss = 0.0f;
+
+	uint32 LastOutTotalPackets = 0;
+	uint32 LastOutTotalPacketsLost = 0;
+
+	bool bSaturatedSinceLastSample = false;
+};
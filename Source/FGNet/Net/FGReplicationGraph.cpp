@@ -0,0 +1,191 @@
+#include "FGReplicationGraph.h"
+#include "Engine/LevelScriptActor.h"
+#include "Engine/NetConnection.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "UObject/UObjectIterator.h"
+#include "../Player/FGPlayer.h"
+#include "../FGPickup.h"
+
+void UFGReplicationGraph::ResetGameWorldState()
+{
+	Super::ResetGameWorldState();
+
+	ActorsWithoutNetConnection.Reset();
+
+	for (auto& Pair : AlwaysRelevantConnectionNodes)
+	{
+		if (Pair.Value != nullptr)
+			Pair.Value->NotifyResetAllNetworkActors();
+	}
+}
+
+void UFGReplicationGraph::InitGlobalActorClassSettings()
+{
+	Super::InitGlobalActorClassSettings();
+
+	ClassRepNodePolicies.Set(ALevelScriptActor::StaticClass(), EFGClassRepNodeMapping::NotRouted);
+	ClassRepNodePolicies.Set(AGameStateBase::StaticClass(), EFGClassRepNodeMapping::RelevantAllConnections);
+	ClassRepNodePolicies.Set(APlayerState::StaticClass(), EFGClassRepNodeMapping::RelevantAllConnections);
+	ClassRepNodePolicies.Set(APlayerController::StaticClass(), EFGClassRepNodeMapping::RelevantOwnerOnly);
+	ClassRepNodePolicies.Set(AFGPlayer::StaticClass(), EFGClassRepNodeMapping::Spatialize_Dynamic);
+	ClassRepNodePolicies.Set(AFGPickup::StaticClass(), EFGClassRepNodeMapping::Spatialize_Static);
+
+	// The graph is frame based, convert every replicated class' NetUpdateFrequency and cull distance once up front.
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		UClass* Class = *It;
+		AActor* ActorCDO = Cast<AActor>(Class->GetDefaultObject());
+		if (ActorCDO == nullptr || !ActorCDO->GetIsReplicated())
+			continue;
+
+		if (Class->GetName().StartsWith(TEXT("SKEL_")) || Class->GetName().StartsWith(TEXT("REINST_")))
+			continue;
+
+		const EFGClassRepNodeMapping Policy = GetMappingPolicy(Class);
+
+		FClassReplicationInfo ClassInfo;
+		ClassInfo.ReplicationPeriodFrame = GetReplicationPeriodFrameForFrequency(ActorCDO->NetUpdateFrequency);
+
+		const bool bSpatialized = Policy == EFGClassRepNodeMapping::Spatialize_Static || Policy == EFGClassRepNodeMapping::Spatialize_Dynamic;
+		ClassInfo.SetCullDistanceSquared(bSpatialized ? ActorCDO->NetCullDistanceSquared : 0.0f);
+
+		GlobalActorReplicationInfoMap.SetClassInfo(Class, ClassInfo);
+	}
+}
+
+void UFGReplicationGraph::InitGlobalGraphNodes()
+{
+	Super::InitGlobalGraphNodes();
+
+	GridNode = CreateNewNode<UReplicationGraphNode_GridSpatialization2D>();
+	GridNode->CellSize = GridCellSize;
+	GridNode->SpatialBias = FVector2D(SpatialBiasX, SpatialBiasY);
+	AddGlobalGraphNode(GridNode);
+
+	AlwaysRelevantNode = CreateNewNode<UReplicationGraphNode_ActorList>();
+	AddGlobalGraphNode(AlwaysRelevantNode);
+}
+
+void UFGReplicationGraph::InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection)
+{
+	Super::InitConnectionGraphNodes(RepGraphConnection);
+
+	UReplicationGraphNode_AlwaysRelevant_ForConnection* AlwaysRelevantConnectionNode = CreateNewNode<UReplicationGraphNode_AlwaysRelevant_ForConnection>();
+	AddConnectionGraphNode(AlwaysRelevantConnectionNode, RepGraphConnection);
+	AlwaysRelevantConnectionNodes.Add(RepGraphConnection->NetConnection, AlwaysRelevantConnectionNode);
+}
+
+void UFGReplicationGraph::RemoveClientConnection(UNetConnection* NetConnection)
+{
+	AlwaysRelevantConnectionNodes.Remove(NetConnection);
+
+	Super::RemoveClientConnection(NetConnection);
+}
+
+void UFGReplicationGraph::RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo)
+{
+	AActor* Actor = ActorInfo.GetActor();
+
+	switch (GetMappingPolicy(Actor->GetClass()))
+	{
+	case EFGClassRepNodeMapping::NotRouted:
+		break;
+
+	case EFGClassRepNodeMapping::RelevantAllConnections:
+		AlwaysRelevantNode->NotifyAddNetworkActor(ActorInfo);
+		break;
+
+	case EFGClassRepNodeMapping::RelevantOwnerOnly:
+		ActorsWithoutNetConnection.Add(Actor);
+		break;
+
+	case EFGClassRepNodeMapping::Spatialize_Static:
+		GridNode->AddActor_Static(ActorInfo, GlobalInfo);
+		break;
+
+	case EFGClassRepNodeMapping::Spatialize_Dynamic:
+		GridNode->AddActor_Dynamic(ActorInfo, GlobalInfo);
+		break;
+	}
+}
+
+void UFGReplicationGraph::RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo)
+{
+	AActor* Actor = ActorInfo.GetActor();
+
+	switch (GetMappingPolicy(Actor->GetClass()))
+	{
+	case EFGClassRepNodeMapping::NotRouted:
+		break;
+
+	case EFGClassRepNodeMapping::RelevantAllConnections:
+		AlwaysRelevantNode->NotifyRemoveNetworkActor(ActorInfo);
+		break;
+
+	case EFGClassRepNodeMapping::RelevantOwnerOnly:
+		if (UReplicationGraphNode_AlwaysRelevant_ForConnection* Node = GetAlwaysRelevantNodeForConnection(Actor->GetNetConnection()))
+			Node->NotifyRemoveNetworkActor(ActorInfo);
+		ActorsWithoutNetConnection.Remove(Actor);
+		break;
+
+	case EFGClassRepNodeMapping::Spatialize_Static:
+		GridNode->RemoveActor_Static(ActorInfo);
+		break;
+
+	case EFGClassRepNodeMapping::Spatialize_Dynamic:
+		GridNode->RemoveActor_Dynamic(ActorInfo);
+		break;
+	}
+}
+
+int32 UFGReplicationGraph::ServerReplicateActors(float DeltaSeconds)
+{
+	// Owner only actors can't be routed until their owning connection is known.
+	for (int32 Index = ActorsWithoutNetConnection.Num() - 1; Index >= 0; --Index)
+	{
+		AActor* Actor = ActorsWithoutNetConnection[Index];
+		if (Actor == nullptr)
+		{
+			ActorsWithoutNetConnection.RemoveAtSwap(Index, 1, false);
+			continue;
+		}
+
+		if (UReplicationGraphNode_AlwaysRelevant_ForConnection* Node = GetAlwaysRelevantNodeForConnection(Actor->GetNetConnection()))
+		{
+			Node->NotifyAddNetworkActor(FNewReplicatedActorInfo(Actor));
+			ActorsWithoutNetConnection.RemoveAtSwap(Index, 1, false);
+		}
+	}
+
+	return Super::ServerReplicateActors(DeltaSeconds);
+}
+
+EFGClassRepNodeMapping UFGReplicationGraph::GetMappingPolicy(const UClass* Class)
+{
+	if (EFGClassRepNodeMapping* Policy = ClassRepNodePolicies.Get(Class))
+		return *Policy;
+
+	// Fall back on the actor's own relevancy flags for classes we don't know about.
+	const AActor* ActorCDO = Cast<AActor>(Class->GetDefaultObject());
+	if (ActorCDO == nullptr)
+		return EFGClassRepNodeMapping::NotRouted;
+
+	if (ActorCDO->bAlwaysRelevant)
+		return EFGClassRepNodeMapping::RelevantAllConnections;
+
+	if (ActorCDO->bOnlyRelevantToOwner)
+		return EFGClassRepNodeMapping::RelevantOwnerOnly;
+
+	return EFGClassRepNodeMapping::Spatialize_Dynamic;
+}
+
+UReplicationGraphNode_AlwaysRelevant_ForConnection* UFGReplicationGraph::GetAlwaysRelevantNodeForConnection(UNetConnection* Connection) const
+{
+	if (Connection == nullptr)
+		return nullptr;
+
+	UReplicationGraphNode_AlwaysRelevant_ForConnection* const* Node = AlwaysRelevantConnectionNodes.Find(Connection);
+	return Node != nullptr ? *Node : nullptr;
+}
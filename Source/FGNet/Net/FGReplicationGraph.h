@@ -0,0 +1,66 @@
+#pragma once
+
+#include "ReplicationGraph.h"
+#include "FGReplicationGraph.generated.h"
+
+class UReplicationGraphNode_GridSpatialization2D;
+class UReplicationGraphNode_ActorList;
+class UReplicationGraphNode_AlwaysRelevant_ForConnection;
+
+enum class EFGClassRepNodeMapping : uint32
+{
+	NotRouted,				// Not routed to a node, only replicated when something else pulls it in.
+	RelevantAllConnections,	// Routed to the always relevant node.
+	RelevantOwnerOnly,		// Routed to the always relevant node of the owning connection.
+	Spatialize_Static,		// Routed to the grid node, never moves.
+	Spatialize_Dynamic,		// Routed to the grid node, updated every frame.
+};
+
+// Replication graph for FGNet. Players and other moving actors are spatialized in a 2D grid so a connection only
+// considers the actors around its viewer and pickups are spatialized statically. Game and player state are relevant
+// to everyone. Rockets aren't replicated, every machine simulates them from the shots the players replicate.
+UCLASS(transient, config = Engine)
+class FGNET_API UFGReplicationGraph : public UReplicationGraph
+{
+	GENERATED_BODY()
+public:
+	virtual void ResetGameWorldState() override;
+
+	virtual void InitGlobalActorClassSettings() override;
+	virtual void InitGlobalGraphNodes() override;
+	virtual void InitConnectionGraphNodes(UNetReplicationGraphConnection* RepGraphConnection) override;
+	virtual void RemoveClientConnection(UNetConnection* NetConnection) override;
+
+	virtual void RouteAddNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo, FGlobalActorReplicationInfo& GlobalInfo) override;
+	virtual void RouteRemoveNetworkActorToNodes(const FNewReplicatedActorInfo& ActorInfo) override;
+
+	virtual int32 ServerReplicateActors(float DeltaSeconds) override;
+
+	UPROPERTY(config)
+		float GridCellSize = 10000.0f;
+
+	UPROPERTY(config)
+		float SpatialBiasX = -150000.0f;
+
+	UPROPERTY(config)
+		float SpatialBiasY = -150000.0f;
+
+private:
+	EFGClassRepNodeMapping GetMappingPolicy(const UClass* Class);
+	UReplicationGraphNode_AlwaysRelevant_ForConnection* GetAlwaysRelevantNodeForConnection(UNetConnection* Connection) const;
+
+	TClassMap<EFGClassRepNodeMapping> ClassRepNodePolicies;
+
+	UPROPERTY()
+		UReplicationGraphNode_GridSpatialization2D* GridNode = nullptr;
+
+	UPROPERTY()
+		UReplicationGraphNode_ActorList* AlwaysRelevantNode = nullptr;
+
+	UPROPERTY()
+		TMap<UNetConnection*, UReplicationGraphNode_AlwaysRelevant_ForConnection*> AlwaysRelevantConnectionNodes;
+
+	// Owner only actors whose owning connection wasn't known yet when they were added.
+	UPROPERTY()
+		TArray<AActor*> ActorsWithoutNetConnection;
+};
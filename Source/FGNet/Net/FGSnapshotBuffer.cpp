@@ -0,0 +1,112 @@
+#include "FGSnapshotBuffer.h"
+#include "FGNetMovementState.h"
+
+void FFGSnapshotBuffer::SetCapacity(int32 InCapacity)
+{
+	Capacity = FMath::Max(InCapacity, 2);
+
+	if (Snapshots.Num() > Capacity)
+	{
+		Snapshots.RemoveAt(0, Snapshots.Num() - Capacity);
+	}
+}
+
+void FFGSnapshotBuffer::Reset()
+{
+	Snapshots.Reset();
+	Depth = 0;
+	bIsExtrapolating = false;
+}
+
+void FFGSnapshotBuffer::Add(const FFGSnapshot& Snapshot)
+{
+	if (Snapshots.Num() > 0 && Snapshot.TimeStamp <= LastRenderTime)
+	{
+		NumLateSnapshots++;
+		return;
+	}
+
+	// Snapshots almost always arrive in order, search from the back.
+	int32 InsertIndex = Snapshots.Num();
+	while (InsertIndex > 0 && Snapshots[InsertIndex - 1].TimeStamp > Snapshot.TimeStamp)
+	{
+		InsertIndex--;
+	}
+
+	if (InsertIndex > 0 && Snapshots[InsertIndex - 1].TimeStamp == Snapshot.TimeStamp)
+		return;
+
+	Snapshots.Insert(Snapshot, InsertIndex);
+
+	if (Snapshots.Num() > Capacity)
+	{
+		Snapshots.RemoveAt(0);
+	}
+}
+
+void FFGSnapshotBuffer::Add(const FFGNetMovementState& State)
+{
+	FFGSnapshot Snapshot;
+	Snapshot.TimeStamp = State.TimeStamp;
+	Snapshot.Location = State.Location;
+	Snapshot.Velocity = State.GetVelocity();
+	Snapshot.Yaw = State.Yaw;
+	Add(Snapshot);
+}
+
+bool FFGSnapshotBuffer::Sample(float RenderTime, float MaxExtrapolationTime, FVector& OutLocation, float& OutYaw)
+{
+	if (Snapshots.Num() == 0)
+		return false;
+
+	LastRenderTime = RenderTime;
+
+	// Drop snapshots that are no longer needed, keep the one right before the render time to interpolate from.
+	int32 NumOld = 0;
+	while (NumOld + 1 < Snapshots.Num() && Snapshots[NumOld + 1].TimeStamp <= RenderTime)
+	{
+		NumOld++;
+	}
+
+	if (NumOld > 0)
+	{
+		Snapshots.RemoveAt(0, NumOld, false);
+	}
+
+	const FFGSnapshot& From = Snapshots[0];
+
+	if (RenderTime < From.TimeStamp)
+	{
+		// Render time hasn't reached the first snapshot yet.
+		Depth = Snapshots.Num();
+		OutLocation = From.Location;
+		OutYaw = From.Yaw;
+		return true;
+	}
+
+	Depth = Snapshots.Num() - 1;
+
+	if (Snapshots.Num() == 1)
+	{
+		if (!bIsExtrapolating)
+		{
+			NumUnderruns++;
+			bIsExtrapolating = true;
+		}
+
+		const float ExtrapolationTime = FMath::Min(RenderTime - From.TimeStamp, MaxExtrapolationTime);
+		OutLocation = From.Location + From.Velocity * ExtrapolationTime;
+		OutYaw = From.Yaw;
+		return true;
+	}
+
+	bIsExtrapolating = false;
+
+	const FFGSnapshot& To = Snapshots[1];
+	const float Duration = To.TimeStamp - From.TimeStamp;
+	const float Alpha = FMath::Clamp((RenderTime - From.TimeStamp) / Duration, 0.0f, 1.0f);
+
+	OutLocation = FMath::CubicInterp(From.Location, From.Velocity * Duration, To.Location, To.Velocity * Duration, Alpha);
+	OutYaw = From.Yaw + FMath::FindDeltaAngleDegrees(From.Yaw, To.Yaw) * Alpha;
+	return true;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FFGNetMovementState;
+
+struct FFGSnapshot
+{
+	float TimeStamp = 0.0f;
+	FVector Location = FVector::ZeroVector;
+	FVector Velocity = FVector::ZeroVector;
+	float Yaw = 0.0f;
+};
+
+// Jitter buffer of server time stamped snapshots for a simulated proxy. Sampled at a render time behind the
+// server clock, interpolating with a Hermite spline between the snapshots around it, and dead reckoning for
+// a bounded time past the newest snapshot when the buffer runs dry.
+class FGNET_API FFGSnapshotBuffer
+{
+public:
+	void SetCapacity(int32 InCapacity);
+	void Reset();
+
+	void Add(const FFGSnapshot& Snapshot);
+	void Add(const FFGNetMovementState& State);
+
+	// Returns false if there is nothing to sample yet.
+	bool Sample(float RenderTime, float MaxExtrapolationTime, FVector& OutLocation, float& OutYaw);
+
+	// Number of snapshots newer than the render time of the last sample.
+	int32 GetDepth() const { return Depth; }
+
+	// Number of times the render time caught up with the newest snapshot.
+	int32 GetNumUnderruns() const { return NumUnderruns; }
+
+	// Number of snapshots that arrived too late to be rendered.
+	int32 GetNumLateSnapshots() const { return NumLateSnapshots; }
+
+	bool IsExtrapolating() const { return bIsExtrapolating; }
+
+private:
+	// Sorted by time stamp, oldest first.
+	TArray<FFGSnapshot> Snapshots;
+
+	int32 Capacity = 32;
+	float LastRenderTime = 0.0f;
+
+	int32 Depth = 0;
+	int32 NumUnderruns = 0;
+	int32 NumLateSnapshots = 0;
+	bool bIsExtrapolating = false;
+};
@@ -0,0 +1,79 @@
+#include "FGTransformHistory.h"
+
+void FFGTransformHistory::SetCapacity(int32 InCapacity)
+{
+	Entries.SetNum(FMath::Max(InCapacity, 2));
+	Reset();
+}
+
+void FFGTransformHistory::Reset()
+{
+	Head = 0;
+	NumEntries = 0;
+}
+
+void FFGTransformHistory::Add(float TimeStamp, const FVector& Location)
+{
+	if (Entries.Num() == 0)
+	{
+		SetCapacity(2);
+	}
+
+	if (NumEntries > 0 && TimeStamp <= GetEntry(NumEntries - 1).TimeStamp)
+		return;
+
+	int32 Index = 0;
+	if (NumEntries < Entries.Num())
+	{
+		Index = (Head + NumEntries) % Entries.Num();
+		NumEntries++;
+	}
+	else
+	{
+		// Full, overwrite the oldest entry.
+		Index = Head;
+		Head = (Head + 1) % Entries.Num();
+	}
+
+	Entries[Index].TimeStamp = TimeStamp;
+	Entries[Index].Location = Location;
+}
+
+bool FFGTransformHistory::GetLocationAtTime(float TimeStamp, FVector& OutLocation) const
+{
+	if (NumEntries == 0)
+		return false;
+
+	const FFGTransformHistoryEntry& Oldest = GetEntry(0);
+	const FFGTransformHistoryEntry& Newest = GetEntry(NumEntries - 1);
+
+	if (TimeStamp <= Oldest.TimeStamp)
+	{
+		OutLocation = Oldest.Location;
+		return true;
+	}
+
+	if (TimeStamp >= Newest.TimeStamp)
+	{
+		OutLocation = Newest.Location;
+		return true;
+	}
+
+	// First entry newer than TimeStamp. Oldest is not newer and Newest is, so it's somewhere in [1, NumEntries - 1].
+	int32 Low = 1;
+	int32 High = NumEntries - 1;
+	while (Low < High)
+	{
+		const int32 Middle = Low + (High - Low) / 2;
+		if (GetEntry(Middle).TimeStamp > TimeStamp)
+			High = Middle;
+		else
+			Low = Middle + 1;
+	}
+
+	const FFGTransformHistoryEntry& From = GetEntry(Low - 1);
+	const FFGTransformHistoryEntry& To = GetEntry(Low);
+	const float Alpha = (TimeStamp - From.TimeStamp) / (To.TimeStamp - From.TimeStamp);
+	OutLocation = FMath::Lerp(From.Location, To.Location, Alpha);
+	return true;
+}
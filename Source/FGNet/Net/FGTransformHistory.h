@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FFGTransformHistoryEntry
+{
+	float TimeStamp = 0.0f;
+	FVector Location = FVector::ZeroVector;
+};
+
+// Fixed size ring buffer of server time stamped locations, used by the server to look up where a player was at
+// the time a shooter saw it. Lookups are a binary search over the time stamps, so their cost only depends on the
+// capacity.
+class FGNET_API FFGTransformHistory
+{
+public:
+	void SetCapacity(int32 InCapacity);
+	void Reset();
+
+	// Entries have to be added in time order, anything not newer than the newest entry is dropped.
+	void Add(float TimeStamp, const FVector& Location);
+
+	// Location at TimeStamp, linearly interpolated between the entries around it and clamped to the oldest and
+	// newest entry. Returns false if the history is empty.
+	bool GetLocationAtTime(float TimeStamp, FVector& OutLocation) const;
+
+	int32 Num() const { return NumEntries; }
+
+private:
+	// Index 0 is the oldest entry.
+	const FFGTransformHistoryEntry& GetEntry(int32 Index) const { return Entries[(Head + Index) % Entries.Num()]; }
+
+	TArray<FFGTransformHistoryEntry> Entries;
+
+	int32 Head = 0;
+	int32 NumEntries = 0;
+};
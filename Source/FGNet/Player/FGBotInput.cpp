@@ -0,0 +1,43 @@
+#include "FGBotInput.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+
+bool FFGBotInput::IsEnabled()
+{
+	static const bool bIsBot = FParse::Param(FCommandLine::Get(), TEXT("FGBot"));
+	return bIsBot;
+}
+
+void FFGBotInput::Initialize()
+{
+	int32 Seed = static_cast<int32>(FPlatformProcess::GetCurrentProcessId());
+	FParse::Value(FCommandLine::Get(), TEXT("FGBotSeed="), Seed);
+	Random.Initialize(Seed);
+
+	TimeUntilNewTarget = 0.0f;
+	TimeUntilFire = Random.FRandRange(0.5f, 2.0f);
+}
+
+void FFGBotInput::Update(float DeltaTime)
+{
+	TimeUntilNewTarget -= DeltaTime;
+	if (TimeUntilNewTarget <= 0.0f)
+	{
+		// Mostly forward, so bots spread over the map instead of circling the spawn.
+		TargetForward = Random.FRandRange(-0.3f, 1.0f);
+		TargetTurn = Random.FRandRange(-1.0f, 1.0f);
+		TimeUntilNewTarget = Random.FRandRange(0.5f, 3.0f);
+	}
+
+	const float InputChangeSpeed = 2.0f;
+	Forward = FMath::FInterpConstantTo(Forward, TargetForward, DeltaTime, InputChangeSpeed);
+	Turn = FMath::FInterpConstantTo(Turn, TargetTurn, DeltaTime, InputChangeSpeed);
+
+	TimeUntilFire -= DeltaTime;
+	bFire = TimeUntilFire <= 0.0f;
+	if (bFire)
+	{
+		TimeUntilFire = Random.FRandRange(0.5f, 2.0f);
+	}
+}
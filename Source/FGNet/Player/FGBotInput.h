@@ -0,0 +1,26 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Random but smooth input for load test bots, enabled with -FGBot on the command line. Picks a new throttle and turn
+// target every few seconds and eases towards it, and fires every now and then. Seeded with -FGBotSeed=, so a run can
+// be repeated.
+struct FGNET_API FFGBotInput
+{
+	static bool IsEnabled();
+
+	void Initialize();
+	void Update(float DeltaTime);
+
+	float Forward = 0.0f;
+	float Turn = 0.0f;
+	bool bFire = false;
+
+private:
+	FRandomStream Random;
+
+	float TargetForward = 0.0f;
+	float TargetTurn = 0.0f;
+	float TimeUntilNewTarget = 0.0f;
+	float TimeUntilFire = 0.0f;
+};
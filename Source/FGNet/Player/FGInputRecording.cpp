@@ -0,0 +1,118 @@
+#include "FGInputRecording.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace FGInputRecording
+{
+	static const uint32 Magic = 0x52494746; // "FGIR"
+	static const uint32 Version = 2;
+
+	static int8 QuantizeAxis(float Value)
+	{
+		return static_cast<int8>(FMath::RoundToInt(FMath::Clamp(Value, -1.0f, 1.0f) * 127.0f));
+	}
+}
+
+void FFGInputRecording::Reset(const FFGRecordedStartState& InStartState)
+{
+	StartState = InStartState;
+	Frames.Reset();
+}
+
+void FFGInputRecording::Add(const FFGRecordedInput& Input)
+{
+	FFrame& Frame = Frames.AddDefaulted_GetRef();
+	Frame.DeltaTime = Input.DeltaTime;
+	Frame.Forward = FGInputRecording::QuantizeAxis(Input.Forward);
+	Frame.Turn = FGInputRecording::QuantizeAxis(Input.Turn);
+	Frame.Flags = (Input.bBrake ? Brake : 0) | (Input.bFire ? Fire : 0);
+}
+
+FFGRecordedInput FFGInputRecording::Get(int32 Index) const
+{
+	const FFrame& Frame = Frames[Index];
+
+	FFGRecordedInput Input;
+	Input.DeltaTime = Frame.DeltaTime;
+	Input.Forward = Frame.Forward / 127.0f;
+	Input.Turn = Frame.Turn / 127.0f;
+	Input.bBrake = (Frame.Flags & Brake) != 0;
+	Input.bFire = (Frame.Flags & Fire) != 0;
+	return Input;
+}
+
+bool FFGInputRecording::SaveToFile(const FString& FileName) const
+{
+	TArray<uint8> Data;
+	FMemoryWriter Writer(Data);
+	const_cast<FFGInputRecording*>(this)->Serialize(Writer);
+	return FFileHelper::SaveArrayToFile(Data, *GetFilePath(FileName));
+}
+
+bool FFGInputRecording::LoadFromFile(const FString& FileName)
+{
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *GetFilePath(FileName)))
+		return false;
+
+	FMemoryReader Reader(Data);
+	Serialize(Reader);
+
+	if (Reader.IsError())
+	{
+		Frames.Reset();
+		return false;
+	}
+
+	return true;
+}
+
+FString FFGInputRecording::GetFilePath(const FString& FileName)
+{
+	if (FPaths::GetPath(FileName).IsEmpty())
+		return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("InputRecordings"), FileName);
+
+	return FileName;
+}
+
+void FFGInputRecording::Serialize(FArchive& Ar)
+{
+	uint32 Magic = FGInputRecording::Magic;
+	uint32 Version = FGInputRecording::Version;
+	Ar << Magic;
+	Ar << Version;
+
+	if (Magic != FGInputRecording::Magic || Version != FGInputRecording::Version)
+	{
+		Ar.SetError();
+		return;
+	}
+
+	Ar << StartState.Location;
+	Ar << StartState.Yaw;
+	Ar << StartState.MovementVelocity;
+
+	int32 NumFrames = Frames.Num();
+	Ar << NumFrames;
+
+	if (Ar.IsLoading())
+	{
+		if (NumFrames < 0 || NumFrames * 7 > Ar.TotalSize() - Ar.Tell())
+		{
+			Ar.SetError();
+			return;
+		}
+
+		Frames.SetNum(NumFrames);
+	}
+
+	for (FFrame& Frame : Frames)
+	{
+		Ar << Frame.DeltaTime;
+		Ar << Frame.Forward;
+		Ar << Frame.Turn;
+		Ar << Frame.Flags;
+	}
+}
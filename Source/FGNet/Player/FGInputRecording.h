@@ -0,0 +1,61 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Input of one locally controlled frame.
+struct FFGRecordedInput
+{
+	float DeltaTime = 0.0f;
+	float Forward = 0.0f;
+	float Turn = 0.0f;
+	bool bBrake = false;
+	bool bFire = false;
+};
+
+// Movement state of the player when the recording started, replays start from it.
+struct FFGRecordedStartState
+{
+	FVector Location = FVector::ZeroVector;
+	float Yaw = 0.0f;
+	float MovementVelocity = 0.0f;
+};
+
+// Per frame player input, stored compactly for saving to disk and replaying. Axes are quantized to a signed byte,
+// every frame takes seven bytes in the file.
+class FGNET_API FFGInputRecording
+{
+public:
+	void Reset(const FFGRecordedStartState& InStartState);
+	void Add(const FFGRecordedInput& Input);
+
+	const FFGRecordedStartState& GetStartState() const { return StartState; }
+
+	int32 Num() const { return Frames.Num(); }
+	FFGRecordedInput Get(int32 Index) const;
+
+	bool SaveToFile(const FString& FileName) const;
+	bool LoadFromFile(const FString& FileName);
+
+	// Names without a directory are put in Saved/InputRecordings.
+	static FString GetFilePath(const FString& FileName);
+
+private:
+	struct FFrame
+	{
+		float DeltaTime = 0.0f;
+		int8 Forward = 0;
+		int8 Turn = 0;
+		uint8 Flags = 0;
+	};
+
+	enum EFrameFlags : uint8
+	{
+		Brake = 1 << 0,
+		Fire = 1 << 1,
+	};
+
+	void Serialize(FArchive& Ar);
+
+	FFGRecordedStartState StartState;
+	TArray<FFrame> Frames;
+};
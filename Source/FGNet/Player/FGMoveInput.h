@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FGMoveInput.generated.h"
+
+// One frame of player input, sent to the server when movement is server authoritative.
+USTRUCT()
+struct FFGMoveInput
+{
+	GENERATED_BODY()
+public:
+	UPROPERTY()
+		uint32 Sequence = 0;
+
+	UPROPERTY()
+		float DeltaTime = 0.0f;
+
+	UPROPERTY()
+		float Forward = 0.0f;
+
+	UPROPERTY()
+		float Turn = 0.0f;
+
+	UPROPERTY()
+		bool bBrake = false;
+};
+
+// Input kept by the owning client until the server has acknowledged it, together with the predicted result.
+struct FFGSavedMove
+{
+	FFGMoveInput Input;
+
+	FVector Location = FVector::ZeroVector;
+	float Yaw = 0.0f;
+	float MovementVelocity = 0.0f;
+};
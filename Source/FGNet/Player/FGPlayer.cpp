@@ -5,14 +5,27 @@
 #include "Components/SphereComponent.h"
 #include "Camera/CameraComponent.h"
 #include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "Net/UnrealNetwork.h"
+#include "Net/Core/PushModel/PushModel.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "GameFramework/PlayerController.h"
 #include "GameFramework/PlayerState.h"
+#include "GameFramework/GameStateBase.h"
 #include "../Components//FGMovementComponent.h"
 #include "../FGMovementStatics.h"
-#include "Net/UnrealNetwork.h"
 #include "FGPlayerSettings.h"
+#include "../Debug/FGCorrectionTelemetry.h"
 #include "../Debug/UI/FGNetDebugWidget.h"
 #include "../FGRocket.h"
 #include "../FGPickup.h"
+#include "../FGNet.h"
+#include "../FGNetStats.h"
+#include "../Subsystems/FGClockSyncSubsystem.h"
+#include "../Subsystems/FGLagCompensationSubsystem.h"
+#include "../Subsystems/FGRocketPoolSubsystem.h"
 
 AFGPlayer::AFGPlayer()
 {
@@ -31,6 +44,8 @@ AFGPlayer::AFGPlayer()
 	CameraComponent = CreateDefaultSubobject<UCameraComponent>(TEXT("CameraComponent"));
 	CameraComponent->SetupAttachment(SpringArmComponent);
 
+	FiredRockets.Owner = this;
+
 	MovementComponent = CreateDefaultSubobject<UFGMovementComponent>(TEXT("MovementComponent"));
 
 	SetReplicateMovement(false);
@@ -41,6 +56,8 @@ void AFGPlayer::BeginPlay()
 	Super::BeginPlay();
 
 	MovementComponent->SetUpdatedComponent(CollisionComponent);
+	MovementComponent->AddVisualComponent(MeshComponent, true);
+	MovementComponent->AddVisualComponent(SpringArmComponent, false);
 
 	CreateDebugWidget();
 	if (DebugMenuInstance != nullptr)
@@ -50,15 +67,63 @@ void AFGPlayer::BeginPlay()
 
 	SpawnRockets();
 
-	BP_OnNumRocketsChanged(NumRockets);
+	MovementSendPolicy.Initialize(PlayerSettings);
+	MovementValidator.Initialize(PlayerSettings);
+	MovementValidator.Reset(GetActorLocation(), GetWorld()->GetTimeSeconds());
+	SnapshotBuffer.SetCapacity(PlayerSettings->SnapshotBufferSize);
+	TransformHistory.SetCapacity(PlayerSettings->TransformHistorySize);
+
+	if (HasAuthority())
+	{
+		if (UFGLagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<UFGLagCompensationSubsystem>())
+			LagCompensation->RegisterPlayer(this);
+	}
+
+	if (FParse::Param(FCommandLine::Get(), TEXT("FGUnlimitedRockets")))
+	{
+		bUnlimitedRockets = true;
+	}
 
-	ServerHealth = PlayerSettings->StartHealth;
-	Health = ServerHealth;
+	if (FFGBotInput::IsEnabled())
+	{
+		BotInput.Initialize();
+	}
+
+	if (HasAuthority())
+	{
+		SetHealth(PlayerSettings->StartHealth);
+	}
+
+	BP_OnNumRocketsChanged(GetNumRockets());
 	BP_OnHealthChanged(Health);
 }
 
+void AFGPlayer::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	FDoRepLifetimeParams Params;
+	Params.bIsPushBased = true;
+	DOREPLIFETIME_WITH_PARAMS_FAST(AFGPlayer, Health, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AFGPlayer, NumRockets, Params);
+	DOREPLIFETIME_WITH_PARAMS_FAST(AFGPlayer, FiredRockets, Params);
+}
+
+void AFGPlayer::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	StopInputRecording();
+	StopInputReplay();
+
+	if (UFGLagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<UFGLagCompensationSubsystem>())
+		LagCompensation->UnregisterPlayer(this);
+}
+
 void AFGPlayer::Tick(float DeltaTime)
 {
+	FGNET_SCOPE_CYCLE_COUNTER(PlayerTick);
+
 	Super::Tick(DeltaTime);
 
 	FireCooldownElapsed -= DeltaTime;
@@ -66,36 +131,368 @@ void AFGPlayer::Tick(float DeltaTime)
 	if (!ensure(PlayerSettings != nullptr))
 		return;
 
+	if (HasAuthority() && FiredRockets.RemoveOlderThan(GetServerWorldTime() - PlayerSettings->FiredRocketRecordLifeTime))
+	{
+		MARK_PROPERTY_DIRTY_FROM_NAME(AFGPlayer, FiredRockets, this);
+	}
+
+	if (PredictedRockets.Num() > 0)
+	{
+		ExpirePredictedRockets();
+	}
+
 	if (IsLocallyControlled())
 	{
-		const float MaxVelocity = PlayerSettings->MaxVelocity;
-		const float Acceleration = PlayerSettings->Acceleration;
-		const float Friction = IsBraking() ? PlayerSettings->BrakingFriction : PlayerSettings->Friction;
-		const float Alpha = FMath::Clamp(FMath::Abs(MovementVelocity / (PlayerSettings->MaxVelocity * 0.75f)), 0.0f, 1.0f);
-		const float TurnSpeed = FMath::InterpEaseOut(0.0f, PlayerSettings->TurnSpeedDefault, Alpha, 5.0f);
-		const float MovementDirection = MovementVelocity > 0.0f ? Turn : -Turn;
+		if (!bCheckedReplayCommandLine)
+		{
+			bCheckedReplayCommandLine = true;
+
+			FString ReplayFileName;
+			if (FParse::Value(FCommandLine::Get(), TEXT("FGReplayInput="), ReplayFileName))
+			{
+				float FixedDeltaTime = 0.0f;
+				FParse::Value(FCommandLine::Get(), TEXT("FGReplayDeltaTime="), FixedDeltaTime);
+				StartInputReplay(ReplayFileName, FixedDeltaTime);
+			}
+		}
+
+		// The frame that started a replay ran with its own delta time, the recording starts with the next one.
+		float SimulationDeltaTime = DeltaTime;
+		if (bInputReplayStarting)
+		{
+			bInputReplayStarting = false;
+			SimulationDeltaTime = 0.0f;
+		}
+		else if (IsReplayingInput())
+		{
+			ReplayInput();
+		}
+		else if (FFGBotInput::IsEnabled())
+		{
+			BotInput.Update(DeltaTime);
+			Handle_Accelerate(BotInput.Forward);
+			Handle_Turn(BotInput.Turn);
+			if (BotInput.bFire)
+				Handle_FirePressed();
+		}
+
+		RecordInput(DeltaTime);
+
+		// The same fixed step on every machine, so the server simulates moves exactly like the client predicted them.
+		const int32 NumSteps = MovementComponent->AdvanceSimulationTime(SimulationDeltaTime);
+		const float StepTime = MovementComponent->GetFixedStepTime();
+
+		if (PlayerSettings->bServerAuthoritativeMovement && !HasAuthority())
+		{
+			for (int32 Step = 0; Step < NumSteps; ++Step)
+			{
+				MovementComponent->BeginSimulationStep();
+				PredictMove(StepTime);
+			}
+
+			SendMoves();
+		}
+		else
+		{
+			FFGMoveInput Move;
+			Move.DeltaTime = StepTime;
+			Move.Forward = Forward;
+			Move.Turn = Turn;
+			Move.bBrake = bBrake;
+
+			for (int32 Step = 0; Step < NumSteps; ++Step)
+			{
+				MovementComponent->BeginSimulationStep();
+				SimulateMove(Move);
+			}
+
+			SendMovementState();
+		}
+
+		MovementComponent->UpdateVisualInterpolation();
+	}
+	else if (HasAuthority() && PlayerSettings->bServerAuthoritativeMovement)
+	{
+		SendMovementState();
+	}
+	else
+	{
+		InterpolateSnapshots();
+	}
+}
+
+void AFGPlayer::InterpolateSnapshots()
+{
+	FGNET_SCOPE_CYCLE_COUNTER(SnapshotInterpolation);
+
+	const float RenderTime = GetServerWorldTime() - PlayerSettings->InterpolationDelay;
+
+	FVector Location;
+	float SnapshotYaw = 0.0f;
+	if (SnapshotBuffer.Sample(RenderTime, PlayerSettings->MaxExtrapolationTime, Location, SnapshotYaw))
+	{
+		SetActorLocationAndRotation(Location, FRotator(0.0f, SnapshotYaw, 0.0f));
+	}
+}
+
+float AFGPlayer::GetServerWorldTime() const
+{
+	const UFGClockSyncSubsystem* ClockSync = GetWorld()->GetSubsystem<UFGClockSyncSubsystem>();
+	if (ClockSync != nullptr && ClockSync->IsSynchronized())
+		return ClockSync->GetServerTime();
+
+	// Until the first pong the game state's replicated time is the best guess.
+	if (const AGameStateBase* GameState = GetWorld()->GetGameState())
+		return GameState->GetServerWorldTimeSeconds();
+
+	return GetWorld()->GetTimeSeconds();
+}
+
+float AFGPlayer::GetRemotePlayersViewTime() const
+{
+	// A server simulating the movement shows everyone where they are, otherwise remote players are interpolated.
+	if (HasAuthority() && PlayerSettings->bServerAuthoritativeMovement)
+		return GetServerWorldTime();
+
+	return GetServerWorldTime() - PlayerSettings->InterpolationDelay;
+}
+
+float AFGPlayer::GetCollisionRadius() const
+{
+	return CollisionComponent->GetScaledSphereRadius();
+}
+
+void AFGPlayer::SimulateMove(const FFGMoveInput& Move)
+{
+	const float DeltaTime = Move.DeltaTime;
+	const float MaxVelocity = PlayerSettings->MaxVelocity;
+	const float Acceleration = PlayerSettings->Acceleration;
+	const float Friction = Move.bBrake ? PlayerSettings->BrakingFriction : PlayerSettings->Friction;
+	const float Alpha = FMath::Clamp(FMath::Abs(MovementVelocity / (PlayerSettings->MaxVelocity * 0.75f)), 0.0f, 1.0f);
+	const float TurnSpeed = FMath::InterpEaseOut(0.0f, PlayerSettings->TurnSpeedDefault, Alpha, 5.0f);
+	const float MovementDirection = MovementVelocity > 0.0f ? Move.Turn : -Move.Turn;
+
+	Yaw += (MovementDirection * TurnSpeed) * DeltaTime;
+	FQuat WantedFacingDirection = FQuat(FVector::UpVector, FMath::DegreesToRadians(Yaw));
+	MovementComponent->SetFacingRotation(WantedFacingDirection);
+
+	FFGFrameMovement FrameMovement = MovementComponent->CreateFrameMovement();
+
+	MovementVelocity += Move.Forward * Acceleration * DeltaTime;
+	MovementVelocity = FMath::Clamp(MovementVelocity, -MaxVelocity, MaxVelocity);
+	MovementVelocity *= FMath::Pow(Friction, DeltaTime);
+
+	MovementComponent->ApplyGravity(DeltaTime);
+	FrameMovement.AddDelta(GetActorForwardVector() * MovementVelocity * DeltaTime);
+	MovementComponent->Move(FrameMovement);
+}
+
+void AFGPlayer::PredictMove(float DeltaTime)
+{
+	if (SavedMoves.Num() != PlayerSettings->MaxSavedMoves)
+	{
+		SavedMoves.SetNum(FMath::Max(PlayerSettings->MaxSavedMoves, 1));
+	}
+
+	FFGMoveInput Move;
+	Move.Sequence = NextMoveSequence++;
+	Move.DeltaTime = FMath::Min(DeltaTime, PlayerSettings->MaxMoveDeltaTime);
+	Move.Forward = Forward;
+	Move.Turn = Turn;
+	Move.bBrake = bBrake;
+	SimulateMove(Move);
+
+	FFGSavedMove& SavedMove = GetSavedMove(Move.Sequence);
+	SavedMove.Input = Move;
+	SaveMoveResult(SavedMove);
+
+	// A parked car without throttle doesn't change, the server only needs those moves as a heartbeat.
+	bHasUnsentActiveMoves |= !FMath::IsNearlyZero(Move.Forward) || !FMath::IsNearlyZero(MovementVelocity);
+}
+
+void AFGPlayer::SendMoves()
+{
+	// Nothing predicted yet.
+	if (NextMoveSequence <= 1 || SavedMoves.Num() == 0)
+		return;
+
+	const FFGSavedMove& Move = GetSavedMove(NextMoveSequence - 1);
+
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	MovementSendPolicy.UpdateCongestion(GetNetConnection(), CurrentTime);
+
+	// Send anyway before the ring overwrites moves that never went out, the next frame may add a full set of substeps.
+	const uint32 NumUnsentMoves = Move.Input.Sequence - LastSentMoveSequence;
+	const bool bRingAlmostFull = NumUnsentMoves + MovementComponent->MaxSubsteps >= static_cast<uint32>(SavedMoves.Num());
+	if (!bRingAlmostFull && !MovementSendPolicy.ShouldSend(CurrentTime, bHasUnsentActiveMoves))
+		return;
+
+	MovementSendPolicy.OnSent(CurrentTime);
+	bHasUnsentActiveMoves = false;
+
+	// Send every move since the last send and resend a few before that, a single lost packet should not cost the server an input.
+	const uint32 NumUnacked = Move.Input.Sequence - LastAckedMoveSequence;
+	const uint32 NumUnsent = Move.Input.Sequence - LastSentMoveSequence;
+	const uint32 NumToSend = FMath::Min3<uint32>(NumUnacked, NumUnsent + PlayerSettings->NumRedundantMoves, SavedMoves.Num());
+	LastSentMoveSequence = Move.Input.Sequence;
+
+	MovesToSend.Reset();
+	for (uint32 Sequence = Move.Input.Sequence - NumToSend + 1; Sequence <= Move.Input.Sequence; ++Sequence)
+	{
+		const FFGSavedMove& MoveToSend = GetSavedMove(Sequence);
+		if (MoveToSend.Input.Sequence == Sequence)
+			MovesToSend.Add(MoveToSend.Input);
+	}
+
+	FGNET_INC_COUNTER(MovesSent);
+	Server_SendMoves(MovesToSend);
+}
+
+void AFGPlayer::SaveMoveResult(FFGSavedMove& SavedMove) const
+{
+	SavedMove.Location = GetActorLocation();
+	SavedMove.Yaw = Yaw;
+	SavedMove.MovementVelocity = MovementVelocity;
+}
+
+FFGSavedMove& AFGPlayer::GetSavedMove(uint32 Sequence)
+{
+	return SavedMoves[Sequence % static_cast<uint32>(SavedMoves.Num())];
+}
+
+void AFGPlayer::SendMovementState()
+{
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	MovementSendPolicy.UpdateCongestion(GetNetConnection(), CurrentTime);
+
+	FFGNetMovementState State = CreateMovementState(MovementStateSequence + 1);
+	const bool bHasChanged = !State.Location.Equals(LastSentMovementState.Location, PlayerSettings->SendLocationThreshold)
+		|| FMath::Abs(FMath::FindDeltaAngleDegrees(State.Yaw, LastSentMovementState.Yaw)) > PlayerSettings->SendYawThreshold;
+
+	if (!MovementSendPolicy.ShouldSend(CurrentTime, bHasChanged))
+		return;
+
+	MovementSendPolicy.OnSent(CurrentTime);
+	MovementStateSequence = State.Sequence;
+	LastSentMovementState = State;
+
+	if (HasAuthority())
+	{
+		State.TimeStamp = GetWorld()->GetTimeSeconds();
+		FGNET_INC_COUNTER(MovementStateSent);
+		Multicast_SendMovementState(State);
+	}
+	else
+	{
+		FGNET_INC_COUNTER(MovementStateSent);
+		Server_SendMovementState(State);
+	}
+}
+
+FFGNetMovementState AFGPlayer::CreateMovementState(uint16 Sequence) const
+{
+	FFGNetMovementState State;
+	State.Location = GetActorLocation();
+	State.Yaw = GetActorRotation().Yaw;
+	State.MovementVelocity = MovementVelocity;
+	State.Sequence = Sequence;
+	return State;
+}
+
+void AFGPlayer::Server_SendMoves_Implementation(const TArray<FFGMoveInput>& Moves)
+{
+	FGNET_SCOPE_CYCLE_COUNTER(ServerSendMoves);
+	FGNET_INC_COUNTER(MovesReceived);
+
+	if (PlayerSettings == nullptr || !PlayerSettings->bServerAuthoritativeMovement)
+		return;
+
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	MoveTimeBudget = FMath::Min(MoveTimeBudget + CurrentTime - LastMoveTimeBudgetUpdate, PlayerSettings->MaxMoveTimeBudget);
+	LastMoveTimeBudgetUpdate = CurrentTime;
+
+	bool bProcessedMove = false;
+	for (const FFGMoveInput& Move : Moves)
+	{
+		// Redundant copies of moves we already simulated.
+		if (Move.Sequence <= LastProcessedMoveSequence)
+			continue;
+
+		// Moves the budget can't pay for are simulated shorter or not at all, the ack corrects the client.
+		FFGMoveInput ClampedMove = Move;
+		ClampedMove.DeltaTime = FMath::Clamp(Move.DeltaTime, 0.0f, FMath::Min(PlayerSettings->MaxMoveDeltaTime, MoveTimeBudget));
+		MoveTimeBudget -= ClampedMove.DeltaTime;
+		ClampedMove.Forward = FMath::Clamp(Move.Forward, -1.0f, 1.0f);
+		ClampedMove.Turn = FMath::Clamp(Move.Turn, -1.0f, 1.0f);
+		SimulateMove(ClampedMove);
 
-		Yaw += (MovementDirection * TurnSpeed) * DeltaTime;
-		FQuat WantedFacingDirection = FQuat(FVector::UpVector, FMath::DegreesToRadians(Yaw));
-		MovementComponent->SetFacingRotation(WantedFacingDirection);
+		LastProcessedMoveSequence = Move.Sequence;
+		bProcessedMove = true;
+	}
+
+	if (!bProcessedMove)
+		return;
+
+	// Other clients get the result through SendMovementState in Tick, at the rate the send policy allows.
+	FGNET_INC_COUNTER(MoveAckSent);
+	Client_AckMove(CreateMovementState(static_cast<uint16>(LastProcessedMoveSequence)));
+}
 
-		FFGFrameMovement FrameMovement = MovementComponent->CreateFrameMovement();
+void AFGPlayer::RecordCorrectionError(float CorrectionError)
+{
+	NumMoveCorrections++;
+	TotalCorrectionError += CorrectionError;
+	MaxCorrectionError = FMath::Max(MaxCorrectionError, CorrectionError);
+	FFGCorrectionTelemetry::PlayerCorrectionError.Add(CorrectionError);
+}
 
-		MovementVelocity += Forward * Acceleration * DeltaTime;
-		MovementVelocity = FMath::Clamp(MovementVelocity, -MaxVelocity, MaxVelocity);
-		MovementVelocity *= FMath::Pow(Friction, DeltaTime);
+void AFGPlayer::Client_AckMove_Implementation(const FFGNetMovementState& State)
+{
+	FGNET_SCOPE_CYCLE_COUNTER(ClientAckMove);
+	FGNET_INC_COUNTER(MoveAckReceived);
 
-		MovementComponent->ApplyGravity();
-		FrameMovement.AddDelta(GetActorForwardVector() * MovementVelocity * DeltaTime);
-		MovementComponent->Move(FrameMovement);
+	// Only the lower 16 bits of the sequence are sent, rebuild the full value from the moves still in flight.
+	const uint32 Sequence = NextMoveSequence - static_cast<uint16>(static_cast<uint16>(NextMoveSequence) - State.Sequence);
+	const FVector& Location = State.Location;
+	const float ServerYaw = State.Yaw;
+
+	if (SavedMoves.Num() == 0 || Sequence <= LastAckedMoveSequence || Sequence >= NextMoveSequence)
+		return;
 
-		Server_SendLocation(GetActorLocation());
-		Server_SendRotation(GetActorRotation());
+	LastAckedMoveSequence = Sequence;
+
+	const float YawTolerance = 1.0f;
+	const FFGSavedMove& AckedMove = GetSavedMove(Sequence);
+	if (AckedMove.Input.Sequence == Sequence
+		&& AckedMove.Location.Equals(Location, PlayerSettings->CorrectionLocationTolerance)
+		&& FMath::Abs(FMath::FindDeltaAngleDegrees(AckedMove.Yaw, ServerYaw)) <= YawTolerance)
+	{
+		// Prediction was correct, nothing to do.
+		return;
 	}
+
+	if (AckedMove.Input.Sequence == Sequence)
+		RecordCorrectionError(FVector::Dist(AckedMove.Location, Location));
 	else
+		NumMoveCorrections++;
+	FGNET_INC_COUNTER(MoveCorrections);
+	FGNET_SCOPE_CYCLE_COUNTER(MoveReplay);
+
+	// Rewind to the authoritative state and replay every move the server has not seen yet.
+	Yaw = ServerYaw;
+	MovementVelocity = State.MovementVelocity;
+	SetActorLocationAndRotation(Location, FRotator(0.0f, ServerYaw, 0.0f));
+	MovementComponent->SetFacingRotation(FQuat(FVector::UpVector, FMath::DegreesToRadians(Yaw)));
+	MovementComponent->WakeUp();
+
+	for (uint32 ReplaySequence = Sequence + 1; ReplaySequence < NextMoveSequence; ++ReplaySequence)
 	{
-		SetActorLocation(FMath::VInterpTo(GetActorLocation(), TargetLocation, DeltaTime, InterpolationSpeed));
-		SetActorRotation(FMath::RInterpTo(GetActorRotation(), TargetRotation, DeltaTime, InterpolationSpeed));
+		FFGSavedMove& SavedMove = GetSavedMove(ReplaySequence);
+		if (SavedMove.Input.Sequence != ReplaySequence)
+			continue;
+
+		SimulateMove(SavedMove.Input);
+		SaveMoveResult(SavedMove);
 	}
 }
 
@@ -116,6 +513,10 @@ void AFGPlayer::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
 
 int32 AFGPlayer::GetPing() const
 {
+	const UFGClockSyncSubsystem* ClockSync = GetWorld()->GetSubsystem<UFGClockSyncSubsystem>();
+	if (ClockSync != nullptr && ClockSync->IsSynchronized())
+		return FMath::RoundToInt(ClockSync->GetRoundTripTime() * 1000.0f);
+
 	if (GetPlayerState())
 	{
 		return static_cast<int32>(GetPlayerState()->GetPing());
@@ -126,64 +527,73 @@ int32 AFGPlayer::GetPing() const
 
 void AFGPlayer::SpawnRockets()
 {
-	if (HasAuthority() && RocketClass != nullptr)
+	if (RocketClass != nullptr)
 	{
-		const int32 RocketCache = 8;
-
-		for (int32 Index = 0; Index < RocketCache; ++Index)
+		if (UFGRocketPoolSubsystem* RocketPool = GetWorld()->GetSubsystem<UFGRocketPoolSubsystem>())
 		{
-			FActorSpawnParameters SpawnParams;
-			SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
-			SpawnParams.ObjectFlags = RF_Transient;
-			SpawnParams.Instigator = this;
-			SpawnParams.Owner = this;
-			AFGRocket* NewRocketInstance = GetWorld()->SpawnActor<AFGRocket>(RocketClass, GetActorLocation(), GetActorRotation(), SpawnParams);
-			RocketInstances.Add(NewRocketInstance);
+			RocketPool->InitializePool(RocketClass);
 		}
 	}
 }
 
 void AFGPlayer::ApplyDamage(int32 DamageValue)
 {
-	if (IsLocallyControlled())
-		Server_OnTakeDamage(DamageValue);
+	if (!HasAuthority())
+		return;
+
+	SetHealth(Health - DamageValue);
 }
 
-void AFGPlayer::Server_OnTakeDamage_Implementation(int32 DamageValue)
+void AFGPlayer::OnPickup(AFGPickup* Pickup)
 {
-	ServerHealth -= DamageValue;
-	Multicast_OnTakeDamage(DamageValue);
+	if (!HasAuthority())
+		return;
+
+	SetNumRockets(NumRockets + Pickup->NumRockets);
 }
 
-void AFGPlayer::Multicast_OnTakeDamage_Implementation(int32 DamageValue)
+void AFGPlayer::SetHealth(int32 NewHealth)
 {
-	Health -= DamageValue;
-	BP_OnHealthChanged(Health);
+	NewHealth = FMath::Clamp<int32>(NewHealth, MIN_int16, MAX_int16);
+	if (!HasAuthority() || Health == NewHealth)
+		return;
+
+	Health = NewHealth;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AFGPlayer, Health, this);
+	// RepNotifies only run on clients.
+	OnRep_Health();
 }
 
-void AFGPlayer::OnPickup(AFGPickup* Pickup)
+void AFGPlayer::SetNumRockets(int32 NewNumRockets)
 {
-	if (IsLocallyControlled())
-		Server_OnPickup(Pickup);
+	NewNumRockets = FMath::Clamp<int32>(NewNumRockets, 0, MAX_int16);
+	if (!HasAuthority() || NumRockets == NewNumRockets)
+		return;
+
+	NumRockets = NewNumRockets;
+	MARK_PROPERTY_DIRTY_FROM_NAME(AFGPlayer, NumRockets, this);
+	OnRep_NumRockets();
 }
 
-void AFGPlayer::Client_OnPickupRockets_Implementation(int32 PickedUpRockets)
+void AFGPlayer::OnRep_Health()
 {
-	NumRockets += PickedUpRockets;
-	BP_OnNumRocketsChanged(NumRockets);
+	BP_OnHealthChanged(Health);
 }
 
-void AFGPlayer::Multicast_OnPickupRockets_Implementation(int32 PickedUpRockets)
+void AFGPlayer::OnRep_NumRockets()
 {
-	NumRockets += PickedUpRockets;
-	BP_OnNumRocketsChanged(NumRockets);
+	BP_OnNumRocketsChanged(GetNumRockets());
 }
 
-void AFGPlayer::Server_OnPickup_Implementation(AFGPickup* Pickup)
+void AFGPlayer::Server_ClockSyncPing_Implementation(uint8 PingId)
 {
-	ServerNumRockets += Pickup->NumRockets;
-	//Client_OnPickupRockets(Pickup->NumRockets);	// usefull if only your HUD needs to update rocket values
-	Multicast_OnPickupRockets(Pickup->NumRockets);	// update rockets value on all connected clients
+	Client_ClockSyncPong(PingId, GetWorld()->GetTimeSeconds());
+}
+
+void AFGPlayer::Client_ClockSyncPong_Implementation(uint8 PingId, float ServerTime)
+{
+	if (UFGClockSyncSubsystem* ClockSync = GetWorld()->GetSubsystem<UFGClockSyncSubsystem>())
+		ClockSync->ReceivePong(PingId, ServerTime);
 }
 
 void AFGPlayer::ShowDebugMenu()
@@ -206,42 +616,252 @@ void AFGPlayer::HideDebugMenu()
 	DebugMenuInstance->BP_OnHideWidget();
 }
 
-void AFGPlayer::Server_SendLocation_Implementation(const FVector& Location)
+void AFGPlayer::StartInputRecording(const FString& FileName)
 {
-	Multicast_SendLocation(Location);
+	FFGRecordedStartState StartState;
+	StartState.Location = GetActorLocation();
+	StartState.Yaw = Yaw;
+	StartState.MovementVelocity = MovementVelocity;
+	InputRecording.Reset(StartState);
+
+	// Recording and replay both start on a step boundary.
+	MovementComponent->ResetSimulationTime();
+	InputRecordingFileName = FileName;
+	bIsRecordingInput = true;
+	bFirePressedThisFrame = false;
 }
 
-void AFGPlayer::Multicast_SendLocation_Implementation(const FVector& Location)
+void AFGPlayer::StopInputRecording()
 {
-	if (!IsLocallyControlled())
+	if (!bIsRecordingInput)
+		return;
+
+	bIsRecordingInput = false;
+
+	if (InputRecording.SaveToFile(InputRecordingFileName))
+		UE_LOG(LogFGNet, Display, TEXT("Saved %d frames of input to %s."), InputRecording.Num(), *FFGInputRecording::GetFilePath(InputRecordingFileName));
+	else
+		UE_LOG(LogFGNet, Error, TEXT("Failed to save input recording to %s."), *FFGInputRecording::GetFilePath(InputRecordingFileName));
+}
+
+void AFGPlayer::RecordInput(float DeltaTime)
+{
+	if (bIsRecordingInput)
 	{
-		TargetLocation = Location;
+		FFGRecordedInput Input;
+		Input.DeltaTime = DeltaTime;
+		Input.Forward = Forward;
+		Input.Turn = Turn;
+		Input.bBrake = bBrake;
+		Input.bFire = bFirePressedThisFrame;
+		InputRecording.Add(Input);
 	}
+
+	bFirePressedThisFrame = false;
 }
 
-void AFGPlayer::Server_SendRotation_Implementation(const FRotator& Rotation)
+bool AFGPlayer::StartInputReplay(const FString& FileName, float FixedDeltaTime)
 {
-	Multicast_SendRotation(Rotation);
+	if (!InputReplay.LoadFromFile(FileName) || InputReplay.Num() == 0)
+	{
+		UE_LOG(LogFGNet, Error, TEXT("Failed to load input recording %s."), *FFGInputRecording::GetFilePath(FileName));
+		return false;
+	}
+
+	if (!IsReplayingInput())
+	{
+		bUsedFixedTimeStepBeforeReplay = FApp::UseFixedTimeStep();
+		FixedDeltaTimeBeforeReplay = FApp::GetFixedDeltaTime();
+	}
+
+	const FFGRecordedStartState& StartState = InputReplay.GetStartState();
+	Yaw = StartState.Yaw;
+	MovementVelocity = StartState.MovementVelocity;
+	SetActorLocationAndRotation(StartState.Location, FRotator(0.0f, Yaw, 0.0f));
+	MovementComponent->SetFacingRotation(FQuat(FVector::UpVector, FMath::DegreesToRadians(Yaw)));
+	MovementComponent->WakeUp();
+	MovementComponent->ResetSimulationTime();
+
+	InputReplayFrame = 0;
+	bInputReplayStarting = true;
+	InputReplayFixedDeltaTime = FixedDeltaTime;
+	InputReplayStartTime = FPlatformTime::Seconds();
+
+	// Takes effect from the next frame, which plays the first recorded one.
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(FixedDeltaTime > 0.0f ? FixedDeltaTime : InputReplay.Get(0).DeltaTime);
+	return true;
 }
 
-void AFGPlayer::Multicast_SendRotation_Implementation(const FRotator& Rotation)
+void AFGPlayer::StopInputReplay()
 {
-	if (!IsLocallyControlled())
+	if (!IsReplayingInput())
+		return;
+
+	const double ReplaySeconds = FPlatformTime::Seconds() - InputReplayStartTime;
+	UE_LOG(LogFGNet, Display, TEXT("Replayed %d frames of input in %.2f s (%.3f ms/frame)."), InputReplayFrame, ReplaySeconds, ReplaySeconds * 1000.0 / FMath::Max(InputReplayFrame, 1));
+
+	InputReplayFrame = INDEX_NONE;
+	bInputReplayStarting = false;
+	Forward = 0.0f;
+	Turn = 0.0f;
+	bBrake = false;
+
+	FApp::SetUseFixedTimeStep(bUsedFixedTimeStepBeforeReplay);
+	FApp::SetFixedDeltaTime(FixedDeltaTimeBeforeReplay);
+
+	if (FParse::Param(FCommandLine::Get(), TEXT("FGReplayExit")))
 	{
-		TargetRotation = Rotation;
+		FPlatformMisc::RequestExit(false);
 	}
 }
 
-int32 AFGPlayer::GetNumActiveRockets() const
+void AFGPlayer::ReplayInput()
 {
-	int32 NumActive = 0;
-	for (AFGRocket* Rocket : RocketInstances)
+	if (InputReplayFrame >= InputReplay.Num())
+	{
+		StopInputReplay();
+		return;
+	}
+
+	const FFGRecordedInput Input = InputReplay.Get(InputReplayFrame++);
+	Forward = Input.Forward;
+	Turn = Input.Turn;
+	bBrake = Input.bBrake;
+
+	if (Input.bFire)
+	{
+		bFirePressedThisFrame = true;
+		FireRocket();
+	}
+
+	if (InputReplayFixedDeltaTime <= 0.0f && InputReplayFrame < InputReplay.Num())
+	{
+		FApp::SetFixedDeltaTime(InputReplay.Get(InputReplayFrame).DeltaTime);
+	}
+}
+
+void AFGPlayer::Server_SendMovementState_Implementation(const FFGNetMovementState& State)
+{
+	FGNET_SCOPE_CYCLE_COUNTER(ServerSendMovementState);
+	FGNET_INC_COUNTER(MovementStateReceived);
+
+	// Location is simulated by the server, don't let the client override it.
+	if (PlayerSettings != nullptr && PlayerSettings->bServerAuthoritativeMovement && !IsLocallyControlled())
+		return;
+
+	// States sent before the client got the last correction, or that arrived out of order.
+	if (!FFGNetMovementState::IsNewerSequence(State.Sequence, LastValidatedMovementStateSequence))
+		return;
+
+	LastValidatedMovementStateSequence = State.Sequence;
+
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	FFGNetMovementState StampedState = State;
+	StampedState.TimeStamp = CurrentTime;
+
+	if (PlayerSettings != nullptr && PlayerSettings->bValidateMovement)
 	{
-		if (!Rocket->IsFree())
-			NumActive++;
+		const FVector PreviousLocation = MovementValidator.GetLocation();
+		EFGMovementValidation Result = MovementValidator.Validate(StampedState, CurrentTime);
+		if (Result != EFGMovementValidation::Rejected && MovementValidator.IsSweepDue(CurrentTime))
+		{
+			FGNET_INC_COUNTER(MovementSweeps);
+			if (!SweepValidatedMove(PreviousLocation, StampedState.Location))
+			{
+				MovementValidator.Reject(StampedState, PreviousLocation, CurrentTime);
+				Result = EFGMovementValidation::Rejected;
+			}
+		}
+
+		if (Result != EFGMovementValidation::Accepted)
+		{
+			if (Result == EFGMovementValidation::Clamped)
+			{
+				FGNET_INC_COUNTER(MovementStatesClamped);
+			}
+			else
+			{
+				FGNET_INC_COUNTER(MovementStatesRejected);
+			}
+
+			// The client continues counting from well past the states it has in flight, so those are dropped above.
+			const uint16 CorrectionSequenceGap = 1024;
+			StampedState.Sequence = State.Sequence + CorrectionSequenceGap;
+			LastValidatedMovementStateSequence = StampedState.Sequence;
+			Client_CorrectMovementState(StampedState);
+		}
 	}
 
-	return NumActive;
+	FGNET_INC_COUNTER(MovementStateSent);
+	Multicast_SendMovementState(StampedState);
+}
+
+bool AFGPlayer::SweepValidatedMove(const FVector& Start, const FVector& End) const
+{
+	// A smaller sphere so touching the floor or a wall the player slides along doesn't count.
+	const FCollisionShape Shape = FCollisionShape::MakeSphere(CollisionComponent->GetScaledSphereRadius() * 0.5f);
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(FGValidateMove), false, this);
+
+	FHitResult Hit;
+	if (!GetWorld()->SweepSingleByObjectType(Hit, Start, End, FQuat::Identity, FCollisionObjectQueryParams(ECC_WorldStatic), Shape, QueryParams))
+		return true;
+
+	// Anything the player could walk up is fine.
+	const float MaxWalkableNormalZ = 0.7f;
+	return Hit.bStartPenetrating || Hit.ImpactNormal.Z >= MaxWalkableNormalZ;
+}
+
+void AFGPlayer::Client_CorrectMovementState_Implementation(const FFGNetMovementState& State)
+{
+	RecordCorrectionError(FVector::Dist(GetActorLocation(), State.Location));
+	FGNET_INC_COUNTER(MoveCorrections);
+
+	Yaw = State.Yaw;
+	MovementVelocity = State.MovementVelocity;
+	SetActorLocationAndRotation(State.Location, State.GetRotation());
+	MovementComponent->SetFacingRotation(FQuat(FVector::UpVector, FMath::DegreesToRadians(Yaw)));
+	MovementComponent->WakeUp();
+	MovementComponent->BeginSimulationStep();
+
+	MovementStateSequence = State.Sequence;
+	LastSentMovementState = State;
+}
+
+void AFGPlayer::Multicast_SendMovementState_Implementation(const FFGNetMovementState& State)
+{
+	FGNET_SCOPE_CYCLE_COUNTER(MulticastSendMovementState);
+
+	// The server runs its own multicasts, only count what came over the network.
+	if (!HasAuthority())
+	{
+		FGNET_INC_COUNTER(MovementStateReceived);
+	}
+
+	// Every state the clients render goes through here on the server first.
+	if (HasAuthority())
+	{
+		TransformHistory.Add(State.TimeStamp, State.Location);
+	}
+
+	if (IsLocallyControlled())
+		return;
+
+	if (bHasReceivedMovementState && !FFGNetMovementState::IsNewerSequence(State.Sequence, LastReceivedMovementStateSequence))
+		return;
+
+	bHasReceivedMovementState = true;
+	LastReceivedMovementStateSequence = State.Sequence;
+
+	SnapshotBuffer.Add(State);
+}
+
+int32 AFGPlayer::GetNumActiveRockets() const
+{
+	if (const UFGRocketPoolSubsystem* RocketPool = GetWorld()->GetSubsystem<UFGRocketPoolSubsystem>())
+		return RocketPool->GetNumActiveRockets(this);
+
+	return 0;
 }
 
 void AFGPlayer::Handle_Accelerate(float Value)
@@ -276,6 +896,10 @@ void AFGPlayer::Handle_DebugMenuPressed()
 
 void AFGPlayer::Handle_FirePressed()
 {
+	if (IsReplayingInput())
+		return;
+
+	bFirePressedThisFrame = true;
 	FireRocket();
 }
 
@@ -284,77 +908,208 @@ void AFGPlayer::FireRocket()
 	if (FireCooldownElapsed > 0.0f)
 		return;
 
-	if (NumRockets <= 0 && !bUnlimitedRockets)
+	if (GetNumRockets() <= 0 && !bUnlimitedRockets)
 		return;
 
-	if (GetNumActiveRockets() >= MaxActiveRockets)
+	UFGRocketPoolSubsystem* RocketPool = GetWorld()->GetSubsystem<UFGRocketPoolSubsystem>();
+	if (!ensure(RocketPool != nullptr))
 		return;
 
-	AFGRocket* NewRocket = GetFreeRocket();
-
-	if (!ensure(NewRocket != nullptr))
+	if (RocketPool->GetNumActiveRockets(this) >= MaxActiveRockets)
 		return;
 
 	FireCooldownElapsed = PlayerSettings->FireCooldown;
 
+	// Quantized like every other machine receives it, so the prediction starts where the server's rocket does.
+	const FVector RocketStartLocation = GetRocketStartLocation().GridSnap(1.0f);
+	const uint16 CompressedYaw = FRotator::CompressAxisToShort(GetActorRotation().Yaw);
+
 	if (GetLocalRole() >= ROLE_AutonomousProxy)
 	{
 		if (HasAuthority())
 		{
-			Server_FireRocket(NewRocket, GetRocketStartLocation(), GetActorRotation());
+			FGNET_INC_COUNTER(FireRocketSent);
+			Server_FireRocket(0, RocketStartLocation, CompressedYaw, GetRemotePlayersViewTime());
 		}
 		else
 		{
-			NumRockets--;
-			NewRocket->StartMoving(GetActorForwardVector(), GetRocketStartLocation());
-			Server_FireRocket(NewRocket, GetRocketStartLocation(), GetActorRotation());
+			// If this machine has no free rocket the shot isn't predicted, the server still fires it.
+			uint16 PredictedShotId = 0;
+			if (AFGRocket* NewRocket = LaunchRocket(RocketStartLocation, GetActorForwardVector(), MaxActiveRockets))
+			{
+				// Zero means not predicted.
+				PredictedShotId = NextPredictedShotId++;
+				if (NextPredictedShotId == 0)
+					NextPredictedShotId = 1;
+
+				FFGPredictedRocket& PredictedRocket = PredictedRockets.AddDefaulted_GetRef();
+				PredictedRocket.ShotId = PredictedShotId;
+				PredictedRocket.Rocket = NewRocket;
+				PredictedRocket.LaunchCount = NewRocket->GetLaunchCount();
+				PredictedRocket.FireTime = GetWorld()->GetTimeSeconds();
+
+				NumUnconfirmedRockets++;
+				BP_OnNumRocketsChanged(GetNumRockets());
+			}
+
+			FGNET_INC_COUNTER(FireRocketSent);
+			Server_FireRocket(PredictedShotId, RocketStartLocation, CompressedYaw, GetRemotePlayersViewTime());
 		}
 	}
 }
 
-void AFGPlayer::Server_FireRocket_Implementation(AFGRocket* NewRocket, const FVector& RocketStartLocation, const FRotator& FacingRotation)
+AFGRocket* AFGPlayer::LaunchRocket(const FVector& RocketStartLocation, const FVector& LaunchDirection, int32 MaxActivePerOwner)
 {
-	if ((ServerNumRockets - 1) < 0 && !bUnlimitedRockets)
+	UFGRocketPoolSubsystem* RocketPool = GetWorld()->GetSubsystem<UFGRocketPoolSubsystem>();
+	AFGRocket* NewRocket = RocketPool != nullptr ? RocketPool->AcquireRocket(this, MaxActivePerOwner) : nullptr;
+	if (NewRocket != nullptr)
 	{
-		Client_RemoveRocket(NewRocket);
+		NewRocket->StartMoving(LaunchDirection, RocketStartLocation);
 	}
-	else
+
+	return NewRocket;
+}
+
+void AFGPlayer::Server_FireRocket_Implementation(uint16 PredictedShotId, const FVector_NetQuantize& RocketStartLocation, uint16 CompressedYaw, float ShooterViewTime)
+{
+	FGNET_SCOPE_CYCLE_COUNTER(ServerFireRocket);
+	FGNET_INC_COUNTER(FireRocketReceived);
+
+	const float ShotYaw = FRotator::DecompressAxisFromShort(CompressedYaw);
+	const float DeltaYaw = FMath::FindDeltaAngleDegrees(ShotYaw, GetActorForwardVector().Rotation().Yaw) * 0.5f;
+	const FRotator FacingRotation(0.0f, ShotYaw + DeltaYaw, 0.0f);
+
+	AFGRocket* NewRocket = nullptr;
+	if (NumRockets > 0 || bUnlimitedRockets)
 	{
-		const float DeltaYaw = FMath::FindDeltaAngleDegrees(FacingRotation.Yaw, GetActorForwardVector().Rotation().Yaw) * 0.5f;
-		const FRotator NewFacingRotation = FacingRotation + FRotator(0.0f, DeltaYaw, 0.0f);
-		ServerNumRockets--;
-		Multicast_FireRocket(NewRocket, RocketStartLocation, NewFacingRotation);
+		NewRocket = LaunchRocket(RocketStartLocation, FacingRotation.Vector(), MaxActiveRockets);
 	}
+
+	if (NewRocket == nullptr)
+	{
+		if (PredictedShotId != 0)
+			Client_RejectRocket(PredictedShotId);
+		return;
+	}
+
+	// The view time comes from the client, never rewind further than the settings allow.
+	const float RewindTime = FMath::Clamp(GetServerWorldTime() - ShooterViewTime, 0.0f, PlayerSettings->MaxLagCompensationTime);
+	NewRocket->SetLagCompensationRewindTime(RewindTime);
+
+	SetNumRockets(NumRockets - 1);
+	FGNET_INC_COUNTER(FireRocketSent);
+
+	FiredRockets.Add(PredictedShotId, RocketStartLocation, FacingRotation.Yaw, GetServerWorldTime());
+	MARK_PROPERTY_DIRTY_FROM_NAME(AFGPlayer, FiredRockets, this);
 }
 
-void AFGPlayer::Multicast_FireRocket_Implementation(AFGRocket* NewRocket, const FVector& RocketStartLocation, const FRotator& FacingRotation)
+void AFGPlayer::OnRocketFired(const FFGFiredRocket& FiredRocket)
 {
-	if (!ensure(NewRocket != nullptr))
+	FGNET_SCOPE_CYCLE_COUNTER(ApplyFiredRocket);
+
+	// The server launched its rocket when it fired.
+	if (HasAuthority())
 		return;
 
-	if (GetLocalRole() == ROLE_AutonomousProxy)
+	FGNET_INC_COUNTER(FireRocketReceived);
+
+	const FVector RocketDirection = FiredRocket.GetFacingRotation().Vector();
+
+	if (GetLocalRole() == ROLE_AutonomousProxy && FiredRocket.PredictedShotId != 0)
 	{
-		NewRocket->ApplyCorrection(FacingRotation.Vector());
+		// Keep the predicted rocket and turn it towards the server's facing. If it already exploded there's
+		// nothing left to adjust.
+		if (AFGRocket* PredictedRocket = ResolvePredictedRocket(FiredRocket.PredictedShotId))
+			PredictedRocket->ApplyCorrection(RocketDirection);
 	}
 	else
 	{
-		NumRockets--;
-		NewRocket->StartMoving(FacingRotation.Vector(), RocketStartLocation);
+		// Everyone else skips shots that arrive after they'd have expired, like the ones a late joiner receives with
+		// the initial state.
+		const bool bIsStale = PlayerSettings != nullptr && GetServerWorldTime() - FiredRocket.ServerTime > PlayerSettings->FiredRocketRecordLifeTime;
+		if (GetLocalRole() == ROLE_AutonomousProxy || !bIsStale)
+		{
+			// The server already enforced the active rocket limit.
+			LaunchRocket(FiredRocket.StartLocation, RocketDirection, MAX_int32);
+		}
 	}
 
 	//Update rocket display value
-	BP_OnNumRocketsChanged(NumRockets);
+	BP_OnNumRocketsChanged(GetNumRockets());
+}
+
+void AFGPlayer::Client_RejectRocket_Implementation(uint16 PredictedShotId)
+{
+	if (AFGRocket* PredictedRocket = ResolvePredictedRocket(PredictedShotId))
+		PredictedRocket->MakeFree();
+
+	BP_OnNumRocketsChanged(GetNumRockets());
 }
 
-void AFGPlayer::Client_RemoveRocket_Implementation(AFGRocket* RocketToRemove)
+AFGRocket* AFGPlayer::ResolvePredictedRocket(uint16 PredictedShotId)
 {
-	RocketToRemove->MakeFree();
+	const int32 Index = PredictedRockets.IndexOfByPredicate([PredictedShotId](const FFGPredictedRocket& PredictedRocket) { return PredictedRocket.ShotId == PredictedShotId; });
+	if (Index == INDEX_NONE)
+		return nullptr;
+
+	const FFGPredictedRocket PredictedRocket = PredictedRockets[Index];
+	PredictedRockets.RemoveAt(Index, 1, false);
+	NumUnconfirmedRockets = FMath::Max(NumUnconfirmedRockets - 1, 0);
+
+	const float ConfirmTime = GetWorld()->GetTimeSeconds() - PredictedRocket.FireTime;
+	NumConfirmedRockets++;
+	TotalRocketConfirmTime += ConfirmTime;
+	MaxRocketConfirmTime = FMath::Max(MaxRocketConfirmTime, ConfirmTime);
+	CSV_CUSTOM_STAT(FGNet, RocketConfirmTimeMs, ConfirmTime * 1000.0f, ECsvCustomStatOp::Set);
+
+	// The pool may have handed the rocket to a later shot after this one exploded.
+	AFGRocket* Rocket = PredictedRocket.Rocket.Get();
+	if (Rocket == nullptr || Rocket->IsFree() || Rocket->GetLaunchCount() != PredictedRocket.LaunchCount)
+		return nullptr;
+
+	return Rocket;
+}
+
+void AFGPlayer::ExpirePredictedRockets()
+{
+	// Shots the server never answered, their record expired before it reached us.
+	const float OldestFireTime = GetWorld()->GetTimeSeconds() - PlayerSettings->PredictedRocketTimeout;
+	const int32 NumExpired = PredictedRockets.RemoveAll([OldestFireTime](const FFGPredictedRocket& PredictedRocket) { return PredictedRocket.FireTime < OldestFireTime; });
+	if (NumExpired > 0)
+	{
+		NumUnconfirmedRockets = FMath::Max(NumUnconfirmedRockets - NumExpired, 0);
+		BP_OnNumRocketsChanged(GetNumRockets());
+	}
 }
 
 void AFGPlayer::Cheat_IncreaseRockets(int32 InNumRockets)
 {
-	if (IsLocallyControlled())
-		NumRockets += InNumRockets;
+#if !UE_BUILD_SHIPPING
+	if (!IsLocallyControlled())
+		return;
+
+	// The rocket count is replicated, only the server can change it.
+	if (HasAuthority())
+		SetNumRockets(NumRockets + InNumRockets);
+	else
+		Server_CheatIncreaseRockets(InNumRockets);
+#endif // !UE_BUILD_SHIPPING
+}
+
+bool AFGPlayer::Server_CheatIncreaseRockets_Validate(int32 InNumRockets)
+{
+#if UE_BUILD_SHIPPING
+	return false;
+#else
+	return true;
+#endif // UE_BUILD_SHIPPING
+}
+
+void AFGPlayer::Server_CheatIncreaseRockets_Implementation(int32 InNumRockets)
+{
+#if !UE_BUILD_SHIPPING
+	SetNumRockets(NumRockets + InNumRockets);
+#endif // !UE_BUILD_SHIPPING
 }
 
 void AFGPlayer::CreateDebugWidget()
@@ -372,30 +1127,41 @@ void AFGPlayer::CreateDebugWidget()
 	}
 }
 
-AFGRocket* AFGPlayer::GetFreeRocket() const
-{
-	for (AFGRocket* Rocket : RocketInstances)
-	{
-		if (Rocket == nullptr)
-			continue;
-
-		if (Rocket->IsFree())
-			return Rocket;
-	}
-
-	return nullptr;
-}
-
 FVector AFGPlayer::GetRocketStartLocation() const
 {
 	const FVector StartLoc = GetActorLocation() + GetActorForwardVector() * 100.0f;
 	return StartLoc;
 }
 
-
-void AFGPlayer::GetLifetimeReplicatedProps(TArray< FLifetimeProperty >& OutLifetimeProps) const
+static AFGPlayer* GetLocalPlayerPawn(UWorld* World)
 {
-	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	const APlayerController* PlayerController = World != nullptr ? World->GetFirstPlayerController() : nullptr;
+	return PlayerController != nullptr ? Cast<AFGPlayer>(PlayerController->GetPawn()) : nullptr;
+}
 
-	DOREPLIFETIME(AFGPlayer, RocketInstances);
-}
\ No newline at end of file
+static FAutoConsoleCommandWithWorldAndArgs RecordInputCommand(
+	TEXT("FGNet.RecordInput"),
+	TEXT("Starts recording the local player's input. Argument: file name, saved in Saved/InputRecordings unless it has a directory."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (AFGPlayer* Player = GetLocalPlayerPawn(World))
+			Player->StartInputRecording(Args.Num() > 0 ? Args[0] : TEXT("Input.fginput"));
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs StopRecordingInputCommand(
+	TEXT("FGNet.StopRecordingInput"),
+	TEXT("Stops recording the local player's input and saves the recording."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (AFGPlayer* Player = GetLocalPlayerPawn(World))
+			Player->StopInputRecording();
+	}));
+
+static FAutoConsoleCommandWithWorldAndArgs ReplayInputCommand(
+	TEXT("FGNet.ReplayInput"),
+	TEXT("Replays a recording through the local player. Arguments: file name, optional fixed delta time overriding the recorded ones."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		if (AFGPlayer* Player = GetLocalPlayerPawn(World))
+			Player->StartInputReplay(Args.Num() > 0 ? Args[0] : TEXT("Input.fginput"), Args.Num() > 1 ? FCString::Atof(*Args[1]) : 0.0f);
+	}));
@@ -1,6 +1,15 @@
 #pragma once
 
 #include "GameFramework/Pawn.h"
+#include "FGBotInput.h"
+#include "FGInputRecording.h"
+#include "FGMoveInput.h"
+#include "../Net/FGFiredRockets.h"
+#include "../Net/FGMovementValidator.h"
+#include "../Net/FGNetMovementState.h"
+#include "../Net/FGNetSendPolicy.h"
+#include "../Net/FGSnapshotBuffer.h"
+#include "../Net/FGTransformHistory.h"
 #include "FGPlayer.generated.h"
 
 class UCameraComponent;
@@ -23,10 +32,13 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
 	virtual void Tick(float DeltaTime) override;
 
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
 	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
 
 	UPROPERTY(EditAnywhere, Category = Settings)
@@ -42,33 +54,78 @@ public:
 		TSubclassOf<UFGNetDebugWidget> DebugMenuClass;
 
 	UFUNCTION(Server, Unreliable)
-		void Server_SendLocation(const FVector& Location);
+		void Server_SendMovementState(const FFGNetMovementState& State);
+
+	// Clock sync pings of UFGClockSyncSubsystem, the server answers with its world time.
+	UFUNCTION(Server, Unreliable)
+		void Server_ClockSyncPing(uint8 PingId);
+
+	UFUNCTION(Client, Unreliable)
+		void Client_ClockSyncPong(uint8 PingId, float ServerTime);
 
+	// Server only, pickups are collected by UFGPickupGridSubsystem.
 	void OnPickup(AFGPickup* Pickup);
 
-	UFUNCTION(Server, Reliable)
-		void Server_OnPickup(AFGPickup* Pickup);
+	UFUNCTION(NetMulticast, Unreliable)
+		void Multicast_SendMovementState(const FFGNetMovementState& State);
 
+	UFUNCTION(Server, Unreliable)
+		void Server_SendMoves(const TArray<FFGMoveInput>& Moves);
+
+	UFUNCTION(Client, Unreliable)
+		void Client_AckMove(const FFGNetMovementState& State);
+
+	// Sent by the server when a movement state failed validation, the client continues from State.
 	UFUNCTION(Client, Reliable)
-		void Client_OnPickupRockets(int32 PickedUpRockets);
+		void Client_CorrectMovementState(const FFGNetMovementState& State);
 
-	UFUNCTION(NetMulticast, Reliable)
-		void Multicast_OnPickupRockets(int32 PickedUpRockets);
+	int32 GetNumMoveCorrections() const { return NumMoveCorrections; }
 
-	UFUNCTION(NetMulticast, Unreliable)
-		void Multicast_SendLocation(const FVector& Location);
+	// Distance between predicted and server location of corrected moves, and of movement states the server corrected.
+	float GetMeanCorrectionError() const { return NumMoveCorrections > 0 ? TotalCorrectionError / NumMoveCorrections : 0.0f; }
+	float GetMaxCorrectionError() const { return MaxCorrectionError; }
 
-	UFUNCTION(Server, Unreliable)
-		void Server_SendRotation(const FRotator& Rotation);
+	// Time between firing a predicted shot and the server's answer to it.
+	float GetMeanRocketConfirmTime() const { return NumConfirmedRockets > 0 ? TotalRocketConfirmTime / NumConfirmedRockets : 0.0f; }
+	float GetMaxRocketConfirmTime() const { return MaxRocketConfirmTime; }
 
-	UFUNCTION(NetMulticast, Unreliable)
-		void Multicast_SendRotation(const FRotator& Rotation);
+	const FFGNetSendPolicy& GetMovementSendPolicy() const { return MovementSendPolicy; }
+
+	UFUNCTION(BlueprintPure)
+		int32 GetSnapshotBufferDepth() const { return SnapshotBuffer.GetDepth(); }
+
+	UFUNCTION(BlueprintPure)
+		int32 GetSnapshotBufferUnderruns() const { return SnapshotBuffer.GetNumUnderruns(); }
+
+	const FFGSnapshotBuffer& GetSnapshotBuffer() const { return SnapshotBuffer; }
+
+	// Locations the server sent to the clients, for lag compensated hit tests. Only filled on the server.
+	const FFGTransformHistory& GetTransformHistory() const { return TransformHistory; }
+
+	float GetCollisionRadius() const;
+	USphereComponent* GetCollisionComponent() const { return CollisionComponent; }
 
 	void ShowDebugMenu();
 	void HideDebugMenu();
 
+	// Records the input of every locally controlled frame until StopInputRecording saves it to FileName.
+	void StartInputRecording(const FString& FileName);
+	void StopInputRecording();
+
+	// Feeds a recording back through Tick instead of the player's input. The engine runs with a fixed time step for
+	// the duration of the replay, using the recorded delta times or FixedDeltaTime if it's above zero. The player is
+	// put back where the recording started and the first recorded frame plays on the next tick.
+	bool StartInputReplay(const FString& FileName, float FixedDeltaTime = 0.0f);
+	void StopInputReplay();
+
+	bool IsReplayingInput() const { return InputReplayFrame != INDEX_NONE; }
+
+	// The owning client subtracts the shots it fired that the server hasn't confirmed yet.
 	UFUNCTION(BlueprintPure)
-		int32 GetNumRockets() const { return NumRockets; }
+		int32 GetNumRockets() const { return NumRockets - NumUnconfirmedRockets; }
+
+	UFUNCTION(BlueprintPure)
+		int32 GetHealth() const { return Health; }
 
 	UFUNCTION(BlueprintImplementableEvent, Category = Player, meta = (DisplayName = "On Num Rockets Changed"))
 		void BP_OnNumRocketsChanged(int32 NewNumRockets);
@@ -82,42 +139,77 @@ public:
 
 	void SpawnRockets();
 
+	// Server only, hits are decided by the server's lag compensated rocket traces.
 	void ApplyDamage(int32 DamageValue);
 
-	UFUNCTION(Server, Reliable)
-		void Server_OnTakeDamage(int32 DamageValue);
-
-	UFUNCTION(NetMulticast, Reliable)
-		void Multicast_OnTakeDamage(int32 DamageValue);
+	// Starts a shot the server fired, called for every shot added to FiredRockets.
+	void OnRocketFired(const FFGFiredRocket& FiredRocket);
 
 private:
 
-	int32 ServerHealth = 0;
+	// Health and rockets are replicated as state instead of sent as events, so late joiners and clients that missed
+	// a packet still end up with the right values. Both are push based, the server only compares them after they
+	// changed and several changes in one frame go out as one update.
+	UPROPERTY(ReplicatedUsing = OnRep_Health)
+		int16 Health = 0;
 
-	int32 Health = 0;
+	UPROPERTY(ReplicatedUsing = OnRep_NumRockets)
+		int16 NumRockets = 0;
 
-	int32 ServerNumRockets = 0;
+	// Predicted shots of the owning client that the server hasn't fired yet.
+	int32 NumUnconfirmedRockets = 0;
 
-	int32 NumRockets = 0;
+	UFUNCTION()
+		void OnRep_Health();
 
-	FVector GetRocketStartLocation() const;
+	UFUNCTION()
+		void OnRep_NumRockets();
 
-	AFGRocket* GetFreeRocket() const;
+	// Server only.
+	void SetHealth(int32 NewHealth);
+	void SetNumRockets(int32 NewNumRockets);
+
+	FVector GetRocketStartLocation() const;
 
+	// Shots are identified by a small id the owning client picks, rockets are local actors every machine pools itself.
 	UFUNCTION(Server, Reliable)
-		void Server_FireRocket(AFGRocket* NewRocket, const FVector& RocketStartLocation, const FRotator& RocketFacingRotation);
+		void Server_FireRocket(uint16 PredictedShotId, const FVector_NetQuantize& RocketStartLocation, uint16 CompressedYaw, float ShooterViewTime);
 
-	UFUNCTION(NetMulticast, Reliable)
-		void Multicast_FireRocket(AFGRocket* NewRocket, const FVector& RocketStartLocation, const FRotator& RocketFacingRotation);
+	UPROPERTY(Replicated)
+		FFGFiredRocketArray FiredRockets;
 
 	UFUNCTION(Client, Reliable)
-		void Client_RemoveRocket(AFGRocket* RocketToRemove);
+		void Client_RejectRocket(uint16 PredictedShotId);
+
+	AFGRocket* LaunchRocket(const FVector& RocketStartLocation, const FVector& LaunchDirection, int32 MaxActivePerOwner);
+
+	// Stops waiting for the server's answer to the shot. Returns its rocket if it's still flying.
+	AFGRocket* ResolvePredictedRocket(uint16 PredictedShotId);
+	void ExpirePredictedRockets();
+
+	// Shots the owning client fired that the server hasn't confirmed or rejected yet.
+	struct FFGPredictedRocket
+	{
+		uint16 ShotId = 0;
+		TWeakObjectPtr<AFGRocket> Rocket;
+		uint32 LaunchCount = 0;
+		float FireTime = 0.0f;
+	};
 
+	TArray<FFGPredictedRocket> PredictedRockets;
+	uint16 NextPredictedShotId = 1;
+
+	int32 NumConfirmedRockets = 0;
+	float TotalRocketConfirmTime = 0.0f;
+	float MaxRocketConfirmTime = 0.0f;
+
+	// Does nothing in shipping builds. UHT doesn't allow UFUNCTIONs inside #if !UE_BUILD_SHIPPING, so the bodies are
+	// compiled out instead and the server RPC fails validation, which drops the client.
 	UFUNCTION(BlueprintCallable)
 		void Cheat_IncreaseRockets(int32 InNumRockets);
 
-	UPROPERTY(Replicated, Transient)
-		TArray<AFGRocket*> RocketInstances;
+	UFUNCTION(Server, Reliable, WithValidation)
+		void Server_CheatIncreaseRockets(int32 InNumRockets);
 
 	UPROPERTY(EditAnywhere, Category = Weapon)
 		TSubclassOf<AFGRocket> RocketClass;
@@ -129,6 +221,71 @@ private:
 	UPROPERTY(EditAnywhere, Category = Weapon)
 		bool bUnlimitedRockets = false;
 
+	void SimulateMove(const FFGMoveInput& Move);
+	void PredictMove(float DeltaTime);
+	void SendMoves();
+	void SaveMoveResult(FFGSavedMove& SavedMove) const;
+	FFGSavedMove& GetSavedMove(uint32 Sequence);
+
+	void SendMovementState();
+	void InterpolateSnapshots();
+	float GetServerWorldTime() const;
+	// Server time of the other players as this machine is showing them.
+	float GetRemotePlayersViewTime() const;
+	FFGNetMovementState CreateMovementState(uint16 Sequence) const;
+
+	TArray<FFGSavedMove> SavedMoves;
+	TArray<FFGMoveInput> MovesToSend;
+
+	uint32 NextMoveSequence = 1;
+	uint32 LastAckedMoveSequence = 0;
+	uint32 LastProcessedMoveSequence = 0;
+	uint32 LastSentMoveSequence = 0;
+
+	// Server only, client time it may still spend on moves.
+	float MoveTimeBudget = 0.0f;
+	float LastMoveTimeBudgetUpdate = 0.0f;
+	bool bHasUnsentActiveMoves = false;
+
+	// Counts a correction from the server, by how far the player was off.
+	void RecordCorrectionError(float CorrectionError);
+
+	int32 NumMoveCorrections = 0;
+	float TotalCorrectionError = 0.0f;
+	float MaxCorrectionError = 0.0f;
+
+	FFGBotInput BotInput;
+
+	void RecordInput(float DeltaTime);
+	void ReplayInput();
+
+	FFGInputRecording InputRecording;
+	FString InputRecordingFileName;
+	bool bIsRecordingInput = false;
+	bool bFirePressedThisFrame = false;
+
+	FFGInputRecording InputReplay;
+	int32 InputReplayFrame = INDEX_NONE;
+	bool bInputReplayStarting = false;
+	float InputReplayFixedDeltaTime = 0.0f;
+	double InputReplayStartTime = 0.0;
+	bool bUsedFixedTimeStepBeforeReplay = false;
+	double FixedDeltaTimeBeforeReplay = 0.0;
+	bool bCheckedReplayCommandLine = false;
+
+	FFGNetSendPolicy MovementSendPolicy;
+	FFGNetMovementState LastSentMovementState;
+
+	// Server only.
+	bool SweepValidatedMove(const FVector& Start, const FVector& End) const;
+
+	FFGMovementValidator MovementValidator;
+	uint16 LastValidatedMovementStateSequence = 0;
+
+	uint16 MovementStateSequence = 0;
+	uint16 LastReceivedMovementStateSequence = 0;
+	bool bHasReceivedMovementState = false;
+
 	void Handle_Accelerate(float Value);
 	void Handle_Turn(float Value);
 	void Handle_BrakePressed();
@@ -153,10 +310,8 @@ private:
 
 	bool bBrake = false;
 
-	float InterpolationSpeed = 10.0f;
-
-	FVector TargetLocation;
-	FRotator TargetRotation;
+	FFGSnapshotBuffer SnapshotBuffer;
+	FFGTransformHistory TransformHistory;
 
 	UPROPERTY(VisibleDefaultsOnly, Category = Collision)
 		USphereComponent* CollisionComponent;
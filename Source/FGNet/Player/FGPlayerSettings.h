@@ -29,4 +29,115 @@ public:
 
 	UPROPERTY(EditAnywhere, Category = Health, meta = (ClampMin = 0))
 		int32 StartHealth = 100;
+
+	// Client sends input to the server which simulates the movement, instead of the client sending its location.
+	UPROPERTY(EditAnywhere, Category = Network)
+		bool bServerAuthoritativeMovement = false;
+
+	// Size of the ring buffer holding moves that the server has not acknowledged yet.
+	UPROPERTY(EditAnywhere, Category = Network, meta = (ClampMin = 8, EditCondition = "bServerAuthoritativeMovement"))
+		int32 MaxSavedMoves = 64;
+
+	// Number of already sent, unacknowledged moves resent together with the newest one to survive packet loss.
+	UPROPERTY(EditAnywhere, Category = Network, meta = (ClampMin = 0, ClampMax = 16, EditCondition = "bServerAuthoritativeMovement"))
+		int32 NumRedundantMoves = 3;
+
+	// The server will not simulate a single move longer than this.
+	UPROPERTY(EditAnywhere, Category = Network, meta = (ClampMin = 0.001, EditCondition = "bServerAuthoritativeMovement"))
+		float MaxMoveDeltaTime = 0.1f;
+
+	// Client time the server saves up for moves that arrive late or in bursts. Every move's DeltaTime is paid from
+	// the time that passed on the server, moves beyond that are clamped so a client can't run faster than the server.
+	UPROPERTY(EditAnywhere, Category = Network, meta = (ClampMin = 0.0, EditCondition = "bServerAuthoritativeMovement"))
+		float MaxMoveTimeBudget = 0.25f;
+
+	// Predicted location may differ this much from the acknowledged server location before the client is corrected.
+	UPROPERTY(EditAnywhere, Category = Network, meta = (ClampMin = 0.0, EditCondition = "bServerAuthoritativeMovement"))
+		float CorrectionLocationTolerance = 2.0f;
+
+	// Upper limit for movement updates sent per second, regardless of frame rate.
+	UPROPERTY(EditAnywhere, Category = "Network|Send Policy", meta = (ClampMin = 1.0))
+		float MaxSendRate = 30.0f;
+
+	// Lower limit the send rate may back off to when the connection is losing packets or is saturated.
+	UPROPERTY(EditAnywhere, Category = "Network|Send Policy", meta = (ClampMin = 1.0))
+		float MinSendRate = 5.0f;
+
+	// Location has to move this far from the last sent update before a new one is sent.
+	UPROPERTY(EditAnywhere, Category = "Network|Send Policy", meta = (ClampMin = 0.0))
+		float SendLocationThreshold = 1.0f;
+
+	// Yaw has to change this many degrees from the last sent update before a new one is sent.
+	UPROPERTY(EditAnywhere, Category = "Network|Send Policy", meta = (ClampMin = 0.0))
+		float SendYawThreshold = 0.5f;
+
+	// An update is still sent this often while nothing changes.
+	UPROPERTY(EditAnywhere, Category = "Network|Send Policy", meta = (ClampMin = 0.1))
+		float IdleHeartbeatInterval = 1.0f;
+
+	// Packet loss ratio (0-1) at which the send rate starts backing off.
+	UPROPERTY(EditAnywhere, Category = "Network|Send Policy", meta = (ClampMin = 0.0, ClampMax = 1.0))
+		float CongestionLossThreshold = 0.05f;
+
+	// Send rate is multiplied by this when congestion is detected.
+	UPROPERTY(EditAnywhere, Category = "Network|Send Policy", meta = (ClampMin = 0.1, ClampMax = 1.0))
+		float SendRateBackoffFactor = 0.5f;
+
+	// Send rate recovers by this many updates per second, each second without congestion.
+	UPROPERTY(EditAnywhere, Category = "Network|Send Policy", meta = (ClampMin = 0.0))
+		float SendRateRecovery = 5.0f;
+
+	// How often packet loss and saturation are sampled.
+	UPROPERTY(EditAnywhere, Category = "Network|Send Policy", meta = (ClampMin = 0.1))
+		float CongestionSampleInterval = 0.5f;
+
+	// The server checks that locations sent by clients are reachable with the movement settings, see FFGMovementValidator.
+	UPROPERTY(EditAnywhere, Category = "Network|Movement Validation", meta = (EditCondition = "!bServerAuthoritativeMovement"))
+		bool bValidateMovement = true;
+
+	// Distance a client may move beyond what's reachable without being corrected, covers quantization and rounding.
+	UPROPERTY(EditAnywhere, Category = "Network|Movement Validation", meta = (ClampMin = 0.0))
+		float MovementValidationTolerance = 50.0f;
+
+	// Seconds of unused movement the server saves up, for states that were delayed and then arrive together.
+	UPROPERTY(EditAnywhere, Category = "Network|Movement Validation", meta = (ClampMin = 0.0))
+		float MaxMovementBudgetTime = 0.5f;
+
+	// A location this much further than reachable is pulled back onto the reachable distance, anything further is rejected.
+	UPROPERTY(EditAnywhere, Category = "Network|Movement Validation", meta = (ClampMin = 0.0))
+		float MaxMovementClampDistance = 300.0f;
+
+	// How often the server sweeps a client's last move against the world, to catch moving through walls.
+	UPROPERTY(EditAnywhere, Category = "Network|Movement Validation", meta = (ClampMin = 0.0))
+		float MovementSweepInterval = 0.5f;
+
+	// Remote players are rendered this far behind the server clock, so there is usually a snapshot on both sides of the render time.
+	UPROPERTY(EditAnywhere, Category = "Network|Interpolation", meta = (ClampMin = 0.0))
+		float InterpolationDelay = 0.1f;
+
+	// How long a remote player is dead reckoned past its newest snapshot before it stops.
+	UPROPERTY(EditAnywhere, Category = "Network|Interpolation", meta = (ClampMin = 0.0))
+		float MaxExtrapolationTime = 0.25f;
+
+	UPROPERTY(EditAnywhere, Category = "Network|Interpolation", meta = (ClampMin = 2))
+		int32 SnapshotBufferSize = 32;
+
+	// Number of sent locations the server keeps per player to rewind it for hit tests.
+	UPROPERTY(EditAnywhere, Category = "Network|Lag Compensation", meta = (ClampMin = 2))
+		int32 TransformHistorySize = 64;
+
+	// The server never rewinds players further back than this, no matter how far behind a shooter claims to be.
+	UPROPERTY(EditAnywhere, Category = "Network|Lag Compensation", meta = (ClampMin = 0.0))
+		float MaxLagCompensationTime = 0.4f;
+
+	// How long a fired shot stays in the replicated shot list. Clients that haven't received it by then never see it,
+	// so this has to cover MaxLagCompensationTime plus a few round trips of a lossy connection. Longer keeps more
+	// records in the list and lets clients still launch shots that arrive this late.
+	UPROPERTY(EditAnywhere, Category = "Network|Rockets", meta = (ClampMin = 0.1))
+		float FiredRocketRecordLifeTime = 1.5f;
+
+	// The owning client stops waiting for the server to confirm or reject a predicted shot after this long. Keep it
+	// above FiredRocketRecordLifeTime, the confirmation can arrive until the record expires.
+	UPROPERTY(EditAnywhere, Category = "Network|Rockets", meta = (ClampMin = 0.1))
+		float PredictedRocketTimeout = 2.0f;
 };
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include "FGClockSyncSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/PlatformTime.h"
+#include "../Player/FGPlayer.h"
+#include "../FGNetStats.h"
+
+void UFGClockSyncSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	ClockSync.Initialize(NumOffsetSamples);
+}
+
+float UFGClockSyncSubsystem::GetServerTime() const
+{
+	const float WorldTime = GetWorld()->GetTimeSeconds();
+	return ClockSync.IsSynchronized() ? ClockSync.GetServerTime(WorldTime) : WorldTime;
+}
+
+void UFGClockSyncSubsystem::ReceivePong(uint8 PingId, float ServerTime)
+{
+	ClockSync.ReceivePong(PingId, ServerTime, FPlatformTime::Seconds(), GetWorld()->GetTimeSeconds());
+
+	CSV_CUSTOM_STAT(FGNet, RoundTripTimeMs, ClockSync.GetRoundTripTime() * 1000.0f, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(FGNet, JitterMs, ClockSync.GetJitter() * 1000.0f, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(FGNet, LossPercent, ClockSync.GetLossRate() * 100.0f, ECsvCustomStatOp::Set);
+}
+
+void UFGClockSyncSubsystem::Tick(float DeltaTime)
+{
+	const double RealTime = FPlatformTime::Seconds();
+	ClockSync.ExpirePings(RealTime, PingTimeout);
+
+	// A burst of pings up front gives the offset filter samples to pick from before gameplay needs the time.
+	const int32 NumBurstPings = NumOffsetSamples;
+	if (NumInitialPings >= NumBurstPings && RealTime - LastPingTime < PingInterval)
+		return;
+
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	AFGPlayer* Player = PlayerController != nullptr ? PlayerController->GetPawn<AFGPlayer>() : nullptr;
+	if (Player == nullptr)
+		return;
+
+	LastPingTime = RealTime;
+	NumInitialPings++;
+	Player->Server_ClockSyncPing(ClockSync.SendPing(RealTime, GetWorld()->GetTimeSeconds()));
+}
+
+bool UFGClockSyncSubsystem::IsTickable() const
+{
+	return !IsTemplate() && GetWorld() != nullptr && GetWorld()->IsNetMode(NM_Client);
+}
+
+TStatId UFGClockSyncSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFGClockSyncSubsystem, STATGROUP_Tickables);
+}
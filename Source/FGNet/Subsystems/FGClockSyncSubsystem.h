@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "../Net/FGClockSync.h"
+#include "FGClockSyncSubsystem.generated.h"
+
+// Synchronizes a client's clock with the server's by exchanging time stamped pings through the local player's pawn,
+// and measures the round trip time, jitter and loss of the connection on the way. On the server and in standalone
+// games the server time is the world's time and the connection values stay zero.
+UCLASS(config = Game)
+class FGNET_API UFGClockSyncSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	bool IsSynchronized() const { return ClockSync.IsSynchronized(); }
+
+	// The server's world time, as close as this machine can tell.
+	float GetServerTime() const;
+
+	// Seconds.
+	float GetRoundTripTime() const { return ClockSync.GetRoundTripTime(); }
+	float GetJitter() const { return ClockSync.GetJitter(); }
+
+	// 0 to 1.
+	float GetLossRate() const { return ClockSync.GetLossRate(); }
+
+	float GetServerTimeOffset() const { return ClockSync.GetServerTimeOffset(); }
+
+	// Called by the local player's pawn when the server answered a ping.
+	void ReceivePong(uint8 PingId, float ServerTime);
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+	// Seconds between pings once the clock is synchronized, the first few are sent every frame.
+	UPROPERTY(config)
+		float PingInterval = 0.25f;
+
+	UPROPERTY(config)
+		float PingTimeout = 2.0f;
+
+	// Number of recent pongs the server time offset is picked from.
+	UPROPERTY(config)
+		int32 NumOffsetSamples = 8;
+
+private:
+	FFGClockSync ClockSync;
+
+	double LastPingTime = 0.0;
+	int32 NumInitialPings = 0;
+};
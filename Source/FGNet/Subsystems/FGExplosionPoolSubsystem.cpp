@@ -0,0 +1,91 @@
+#include "FGExplosionPoolSubsystem.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Particles/ParticleSystem.h"
+#include "Particles/ParticleSystemComponent.h"
+#include "../FGNetStats.h"
+
+void UFGExplosionPoolSubsystem::Prewarm(UParticleSystem* Template)
+{
+	UWorld* World = GetWorld();
+	if (Template == nullptr || Components.Num() > 0 || World->GetNetMode() == NM_DedicatedServer)
+		return;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.ObjectFlags = RF_Transient;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	PoolActor = World->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+	if (PoolActor == nullptr)
+		return;
+
+	const int32 NumComponents = FMath::Max(PoolSize, 1);
+	Components.Reserve(NumComponents);
+	for (int32 Index = 0; Index < NumComponents; ++Index)
+	{
+		UParticleSystemComponent* Component = NewObject<UParticleSystemComponent>(PoolActor);
+		Component->bAutoActivate = false;
+		Component->bAutoDestroy = false;
+		Component->SetAbsolute(true, true, true);
+		Component->SetTemplate(Template);
+		Component->RegisterComponent();
+		Components.Add(Component);
+	}
+}
+
+void UFGExplosionPoolSubsystem::PlayExplosion(UParticleSystem* Template, const FVector& Location, const FRotator& Rotation)
+{
+	if (Template == nullptr || GetWorld()->GetNetMode() == NM_DedicatedServer)
+		return;
+
+	if (!CanBeSeen(Location))
+	{
+		FGNET_INC_COUNTER(ExplosionsCulled);
+		return;
+	}
+
+	Prewarm(Template);
+	if (Components.Num() == 0)
+		return;
+
+	UParticleSystemComponent* Component = Components[NextComponent];
+	NextComponent = (NextComponent + 1) % Components.Num();
+
+	// A miss means the pool is too small for this many explosions at once.
+	if (Component->IsActive() && !Component->HasCompleted())
+	{
+		FGNET_INC_COUNTER(ExplosionPoolMisses);
+	}
+	else
+	{
+		FGNET_INC_COUNTER(ExplosionPoolHits);
+	}
+
+	if (Component->Template != Template)
+		Component->SetTemplate(Template);
+
+	Component->SetWorldLocationAndRotation(Location, Rotation);
+	Component->ActivateSystem(true);
+}
+
+bool UFGExplosionPoolSubsystem::CanBeSeen(const FVector& Location) const
+{
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	const APlayerCameraManager* CameraManager = PlayerController != nullptr ? PlayerController->PlayerCameraManager : nullptr;
+	if (CameraManager == nullptr)
+		return true;
+
+	const FVector ToExplosion = Location - CameraManager->GetCameraLocation();
+	const float Distance = ToExplosion.Size();
+	if (Distance > MaxDistance)
+		return false;
+
+	if (Distance <= ExplosionRadius)
+		return true;
+
+	// Widen the view cone by the angle the explosion covers at that distance.
+	const float HalfFOV = FMath::DegreesToRadians(CameraManager->GetFOVAngle() * 0.5f);
+	const float Margin = FMath::Asin(ExplosionRadius / Distance);
+	const float CosAngle = FVector::DotProduct(ToExplosion / Distance, CameraManager->GetCameraRotation().Vector());
+	return CosAngle >= FMath::Cos(FMath::Min(HalfFOV + Margin, PI));
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "FGExplosionPoolSubsystem.generated.h"
+
+class UParticleSystem;
+class UParticleSystemComponent;
+
+// A fixed number of explosion particle components, created once and reused round robin instead of spawning and
+// destroying a component per explosion. When every component is busy the oldest explosion is cut short. Nothing is
+// played on a dedicated server, nor for explosions the local player can't see.
+UCLASS(config = Game)
+class FGNET_API UFGExplosionPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	// Creates the components up front so the first explosions don't pay for it.
+	void Prewarm(UParticleSystem* Template);
+
+	void PlayExplosion(UParticleSystem* Template, const FVector& Location, const FRotator& Rotation);
+
+	UPROPERTY(config)
+		int32 PoolSize = 16;
+
+	// Explosions further away from the camera than this aren't played.
+	UPROPERTY(config)
+		float MaxDistance = 15000.0f;
+
+	// Explosions closer to the edge of the view than this are still played, so the ones just off screen aren't missed.
+	UPROPERTY(config)
+		float ExplosionRadius = 500.0f;
+
+private:
+	bool CanBeSeen(const FVector& Location) const;
+
+	UPROPERTY(Transient)
+		AActor* PoolActor = nullptr;
+
+	UPROPERTY(Transient)
+		TArray<UParticleSystemComponent*> Components;
+
+	int32 NextComponent = 0;
+};
@@ -0,0 +1,68 @@
+#include "FGLagCompensationSubsystem.h"
+#include "Components/SphereComponent.h"
+#include "../Player/FGPlayer.h"
+
+void UFGLagCompensationSubsystem::RegisterPlayer(AFGPlayer* Player)
+{
+	if (Player != nullptr)
+		Players.AddUnique(Player);
+}
+
+void UFGLagCompensationSubsystem::UnregisterPlayer(AFGPlayer* Player)
+{
+	Players.RemoveSwap(Player);
+}
+
+bool UFGLagCompensationSubsystem::TraceRewound(const FVector& Start, const FVector& End, float ViewTime, const AActor* IgnoreActor, FHitResult& OutHit) const
+{
+	const FVector Direction = End - Start;
+	const float A = Direction.SizeSquared();
+	if (A <= KINDA_SMALL_NUMBER)
+		return false;
+
+	AFGPlayer* HitPlayer = nullptr;
+	FVector HitCenter = FVector::ZeroVector;
+	float HitTime = 1.0f;
+
+	for (AFGPlayer* Player : Players)
+	{
+		if (Player == nullptr || Player == IgnoreActor)
+			continue;
+
+		FVector Center;
+		if (!Player->GetTransformHistory().GetLocationAtTime(ViewTime, Center))
+			continue;
+
+		// First intersection of the segment with the player's collision sphere.
+		const float Radius = Player->GetCollisionRadius();
+		const FVector ToStart = Start - Center;
+		const float B = 2.0f * (ToStart | Direction);
+		const float C = ToStart.SizeSquared() - Radius * Radius;
+		const float Discriminant = B * B - 4.0f * A * C;
+		if (Discriminant < 0.0f)
+			continue;
+
+		const float Time = C <= 0.0f ? 0.0f : (-B - FMath::Sqrt(Discriminant)) / (2.0f * A);
+		if (Time < 0.0f || Time > HitTime)
+			continue;
+
+		HitPlayer = Player;
+		HitCenter = Center;
+		HitTime = Time;
+	}
+
+	if (HitPlayer == nullptr)
+		return false;
+
+	const FVector Location = Start + Direction * HitTime;
+	const FVector Normal = (Location - HitCenter).GetSafeNormal();
+	OutHit = FHitResult(HitPlayer, HitPlayer->GetCollisionComponent(), Location, Normal);
+	OutHit.bBlockingHit = true;
+	OutHit.ImpactPoint = Location;
+	OutHit.ImpactNormal = Normal;
+	OutHit.TraceStart = Start;
+	OutHit.TraceEnd = End;
+	OutHit.Time = HitTime;
+	OutHit.Distance = Direction.Size() * HitTime;
+	return true;
+}
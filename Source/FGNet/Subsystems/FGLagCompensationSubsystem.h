@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "FGLagCompensationSubsystem.generated.h"
+
+class AFGPlayer;
+
+// Server side hit tests against players rewound to the time a shooter saw them. Every player keeps a history of
+// the locations the server sent to the clients, a test costs a binary search and a sphere test per player.
+UCLASS()
+class FGNET_API UFGLagCompensationSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	void RegisterPlayer(AFGPlayer* Player);
+	void UnregisterPlayer(AFGPlayer* Player);
+
+	// Finds the first player the segment from Start to End touches, with every player moved to where it was at
+	// ViewTime. Only reads player histories, so it's safe to call from worker threads while the game thread waits.
+	bool TraceRewound(const FVector& Start, const FVector& End, float ViewTime, const AActor* IgnoreActor, FHitResult& OutHit) const;
+
+private:
+	UPROPERTY(Transient)
+		TArray<AFGPlayer*> Players;
+};
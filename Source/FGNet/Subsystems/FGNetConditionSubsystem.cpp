@@ -0,0 +1,151 @@
+#include "FGNetConditionSubsystem.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "Net/DataChannel.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "../FGNet.h"
+
+void UFGNetConditionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	FString ProfileName;
+	if (FParse::Value(FCommandLine::Get(), TEXT("FGNetProfile="), ProfileName))
+	{
+		SetProfile(ProfileName);
+	}
+}
+
+bool UFGNetConditionSubsystem::SetProfile(const FString& NameOrPath)
+{
+	const FName ProfileName(*NameOrPath);
+	if (const FFGNetConditionProfileData* Profile = Profiles.FindByPredicate([ProfileName](const FFGNetConditionProfileData& Data) { return Data.Name == ProfileName; }))
+	{
+		SetProfile(*Profile);
+		return true;
+	}
+
+	if (const UFGNetConditionProfile* ProfileAsset = LoadObject<UFGNetConditionProfile>(nullptr, *NameOrPath))
+	{
+		SetProfile(ProfileAsset->Profile);
+		return true;
+	}
+
+	UE_LOG(LogFGNet, Warning, TEXT("Network condition profile %s not found."), *NameOrPath);
+	return false;
+}
+
+void UFGNetConditionSubsystem::SetProfile(const FFGNetConditionProfileData& Profile)
+{
+	ActiveProfile = Profile;
+	ProfileTime = 0.0f;
+	bHasProfile = true;
+	bHasAppliedConditions = false;
+
+	UE_LOG(LogFGNet, Display, TEXT("Network condition profile %s active."), *Profile.Name.ToString());
+}
+
+void UFGNetConditionSubsystem::SetConditions(const FFGNetConditions& Conditions)
+{
+	FFGNetConditionProfileData Profile;
+	Profile.Name = TEXT("Custom");
+	Profile.Base = Conditions;
+	SetProfile(Profile);
+	Tick(0.0f);
+}
+
+void UFGNetConditionSubsystem::ClearProfile()
+{
+	if (!bHasProfile)
+		return;
+
+	bHasProfile = false;
+	ApplyConditions(FFGNetConditions());
+}
+
+void UFGNetConditionSubsystem::Tick(float DeltaTime)
+{
+	ProfileTime += DeltaTime;
+
+	const FFGNetConditions Conditions = ActiveProfile.GetConditionsAtTime(ProfileTime);
+	if (!bHasAppliedConditions || Conditions != AppliedConditions || AppliedNetDriver != GetWorld()->GetNetDriver())
+	{
+		ApplyConditions(Conditions);
+	}
+}
+
+bool UFGNetConditionSubsystem::IsTickable() const
+{
+	return !IsTemplate() && bHasProfile && GetWorld() != nullptr && GetWorld()->GetNetDriver() != nullptr;
+}
+
+TStatId UFGNetConditionSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFGNetConditionSubsystem, STATGROUP_Tickables);
+}
+
+void UFGNetConditionSubsystem::ApplyConditions(const FFGNetConditions& Conditions)
+{
+	UNetDriver* NetDriver = GetWorld() != nullptr ? GetWorld()->GetNetDriver() : nullptr;
+	if (NetDriver == nullptr)
+		return;
+
+	// Connection rates are only touched when a cap changes, so the defaults stay in place without caps.
+	const bool bIsNewNetDriver = AppliedNetDriver != NetDriver;
+	const bool bUpBandwidthChanged = Conditions.UpBandwidth != AppliedConditions.UpBandwidth || (bIsNewNetDriver && Conditions.UpBandwidth > 0);
+	const bool bDownBandwidthChanged = Conditions.DownBandwidth != AppliedConditions.DownBandwidth || (bIsNewNetDriver && Conditions.DownBandwidth > 0);
+
+	AppliedConditions = Conditions;
+	AppliedNetDriver = NetDriver;
+	bHasAppliedConditions = true;
+
+#if DO_ENABLE_NET_TEST
+	FPacketSimulationSettings PacketSimulation;
+	Conditions.ToPacketSimulationSettings(PacketSimulation);
+	NetDriver->SetPacketSimulationSettings(PacketSimulation);
+#endif // DO_ENABLE_NET_TEST
+
+	// Bandwidth is capped by the rate the sending side of a connection is allowed to use.
+	const int32 UpRate = Conditions.UpBandwidth > 0 ? Conditions.UpBandwidth : NetDriver->MaxClientRate;
+	if (UNetConnection* ServerConnection = NetDriver->ServerConnection)
+	{
+		if (bUpBandwidthChanged)
+		{
+			ServerConnection->CurrentNetSpeed = UpRate;
+		}
+
+		// The server sends to a client at the rate the client asks for.
+		if (bDownBandwidthChanged)
+		{
+			int32 DownRate = Conditions.DownBandwidth > 0 ? Conditions.DownBandwidth : NetDriver->MaxClientRate;
+			FNetControlMessage<NMT_Netspeed>::Send(ServerConnection, DownRate);
+		}
+	}
+	else if (bUpBandwidthChanged)
+	{
+		for (UNetConnection* Connection : NetDriver->ClientConnections)
+		{
+			Connection->CurrentNetSpeed = UpRate;
+		}
+	}
+
+	UE_LOG(LogFGNet, Verbose, TEXT("Network conditions: up %d+%d ms %d%% loss, down %d+%d ms %d%% loss."),
+		Conditions.UpLatency, Conditions.UpJitter, Conditions.UpLoss, Conditions.DownLatency, Conditions.DownJitter, Conditions.DownLoss);
+}
+
+static FAutoConsoleCommandWithWorldAndArgs NetProfileCommand(
+	TEXT("FGNet.NetProfile"),
+	TEXT("Applies a network condition profile by name or asset path. 'none' turns simulated conditions off."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+	{
+		UFGNetConditionSubsystem* NetConditions = World != nullptr ? World->GetSubsystem<UFGNetConditionSubsystem>() : nullptr;
+		if (NetConditions == nullptr || Args.Num() == 0)
+			return;
+
+		if (Args[0] == TEXT("none"))
+			NetConditions->ClearProfile();
+		else
+			NetConditions->SetProfile(Args[0]);
+	}));
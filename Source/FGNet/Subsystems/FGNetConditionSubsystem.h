@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "../Net/FGNetConditionProfile.h"
+#include "FGNetConditionSubsystem.generated.h"
+
+class UNetDriver;
+
+// Applies simulated network conditions to the world's net driver and plays profile timelines. A profile is picked
+// with -FGNetProfile=<name or asset path> on the command line or with the FGNet.NetProfile console command.
+UCLASS(config = Game)
+class FGNET_API UFGNetConditionSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	// Looks the name up in Profiles first, then tries to load it as a UFGNetConditionProfile asset.
+	bool SetProfile(const FString& NameOrPath);
+	void SetProfile(const FFGNetConditionProfileData& Profile);
+
+	// Fixed conditions without a timeline, replaces the active profile.
+	void SetConditions(const FFGNetConditions& Conditions);
+
+	void ClearProfile();
+
+	bool HasProfile() const { return bHasProfile; }
+	const FFGNetConditions& GetAppliedConditions() const { return AppliedConditions; }
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+	UPROPERTY(config)
+		TArray<FFGNetConditionProfileData> Profiles;
+
+private:
+	void ApplyConditions(const FFGNetConditions& Conditions);
+
+	FFGNetConditionProfileData ActiveProfile;
+	FFGNetConditions AppliedConditions;
+	float ProfileTime = 0.0f;
+	bool bHasProfile = false;
+	bool bHasAppliedConditions = false;
+
+	// Conditions are applied again when the world gets a new net driver.
+	TWeakObjectPtr<UNetDriver> AppliedNetDriver;
+};
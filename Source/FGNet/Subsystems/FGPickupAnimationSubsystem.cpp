@@ -0,0 +1,143 @@
+#include "FGPickupAnimationSubsystem.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/IConsoleManager.h"
+#include "../FGPickup.h"
+#include "../FGNet.h"
+#include "../FGNetStats.h"
+
+void UFGPickupAnimationSubsystem::RegisterPickup(AFGPickup* Pickup)
+{
+	if (Pickup == nullptr || Pickup->AnimationIndex != INDEX_NONE)
+		return;
+
+	Pickup->AnimationIndex = Pickups.Add(Pickup);
+}
+
+void UFGPickupAnimationSubsystem::UnregisterPickup(AFGPickup* Pickup)
+{
+	if (Pickup == nullptr || Pickup->AnimationIndex == INDEX_NONE)
+		return;
+
+	const int32 Index = Pickup->AnimationIndex;
+	Pickups.RemoveAtSwap(Index, 1, false);
+	if (Pickups.IsValidIndex(Index))
+	{
+		Pickups[Index]->AnimationIndex = Index;
+	}
+
+	Pickup->AnimationIndex = INDEX_NONE;
+}
+
+void UFGPickupAnimationSubsystem::Animate(float Time, bool bOnlyVisible)
+{
+	FGNET_SCOPE_CYCLE_COUNTER(PickupAnimation);
+
+	// Every pickup is in the same phase, so the offset only has to be worked out once.
+	const FVector BobOffset(0.0f, 0.0f, FMath::MakePulsatingValue(Time, BobFrequency) * BobHeight);
+	const FRotator Spin(0.0f, FMath::Fmod(Time * SpinSpeed, 360.0f), 0.0f);
+	const float RecentlyRenderedTolerance = 0.2f;
+
+	for (AFGPickup* Pickup : Pickups)
+	{
+		if (Pickup->IsPickedUp())
+			continue;
+
+		if (bOnlyVisible && !Pickup->WasRecentlyRendered(RecentlyRenderedTolerance))
+			continue;
+
+		// The mesh doesn't generate overlaps, a plain teleport is enough and skips the sweep and physics update.
+		Pickup->MeshComponent->SetRelativeLocationAndRotation(Pickup->CachedMeshRelativeLocation + BobOffset, Spin, false, nullptr, ETeleportType::None);
+	}
+}
+
+void UFGPickupAnimationSubsystem::Tick(float DeltaTime)
+{
+	Animate(GetWorld()->GetTimeSeconds(), true);
+}
+
+bool UFGPickupAnimationSubsystem::IsTickable() const
+{
+	return !IsTemplate() && Pickups.Num() > 0;
+}
+
+TStatId UFGPickupAnimationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFGPickupAnimationSubsystem, STATGROUP_Tickables);
+}
+
+// Compares the per pickup tick this subsystem replaced with the batched pass, run it in a game client.
+static void BenchmarkPickups(const TArray<FString>& Args, UWorld* World)
+{
+	if (World == nullptr || World->GetNetMode() == NM_DedicatedServer)
+	{
+		UE_LOG(LogFGNet, Warning, TEXT("FGNet.BenchmarkPickups needs a world that renders."));
+		return;
+	}
+
+	UFGPickupAnimationSubsystem* PickupAnimation = World->GetSubsystem<UFGPickupAnimationSubsystem>();
+	if (PickupAnimation == nullptr)
+		return;
+
+	const int32 NumPickups = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 300;
+	const int32 NumFrames = 60;
+	const float DeltaTime = 1.0f / 60.0f;
+
+	// Use the pickups placed in the map as template, so the meshes cost what they cost in game.
+	TSubclassOf<AFGPickup> PickupClass = AFGPickup::StaticClass();
+	for (TActorIterator<AFGPickup> It(World); It; ++It)
+	{
+		PickupClass = It->GetClass();
+		break;
+	}
+
+	TArray<AFGPickup*> BenchmarkPickups;
+	for (int32 Index = 0; Index < NumPickups; ++Index)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		SpawnParams.ObjectFlags = RF_Transient;
+		const FVector Location(Index % 20 * 200.0f, Index / 20 * 200.0f, 100000.0f);
+		BenchmarkPickups.Add(World->SpawnActor<AFGPickup>(PickupClass, Location, FRotator::ZeroRotator, SpawnParams));
+	}
+
+	// What every pickup used to do in its own tick.
+	const double PerActorStart = FPlatformTime::Seconds();
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		const float Time = World->GetTimeSeconds() + Frame * DeltaTime;
+		for (AFGPickup* Pickup : BenchmarkPickups)
+		{
+			const float PulsatingValue = FMath::MakePulsatingValue(Time, PickupAnimation->BobFrequency) * PickupAnimation->BobHeight;
+			FHitResult Hit;
+			Pickup->MeshComponent->SetRelativeLocation(FVector(0.0f, 0.0f, PulsatingValue), false, &Hit, ETeleportType::TeleportPhysics);
+			Pickup->MeshComponent->SetRelativeRotation(FRotator(0.0f, Time * PickupAnimation->SpinSpeed, 0.0f), false, &Hit, ETeleportType::TeleportPhysics);
+		}
+	}
+	const double PerActorSeconds = FPlatformTime::Seconds() - PerActorStart;
+
+	// Visibility culling is off so both runs move every pickup, in game hidden pickups are skipped on top of this.
+	const double BatchedStart = FPlatformTime::Seconds();
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		PickupAnimation->Animate(World->GetTimeSeconds() + Frame * DeltaTime, false);
+	}
+	const double BatchedSeconds = FPlatformTime::Seconds() - BatchedStart;
+
+	const int32 NumAnimated = PickupAnimation->GetNumPickups();
+
+	for (AFGPickup* Pickup : BenchmarkPickups)
+	{
+		Pickup->Destroy();
+	}
+
+	UE_LOG(LogFGNet, Display, TEXT("%d pickups: per actor tick %.3f ms/frame, batched %.3f ms/frame for %d registered pickups"),
+		NumPickups, PerActorSeconds * 1000.0 / NumFrames, BatchedSeconds * 1000.0 / NumFrames, NumAnimated);
+	UE_LOG(LogFGNet, Display, TEXT("Per actor numbers exclude the tick function dispatch the engine adds for every ticking actor."));
+}
+
+static FAutoConsoleCommandWithWorldAndArgs BenchmarkPickupsCommand(
+	TEXT("FGNet.BenchmarkPickups"),
+	TEXT("Measures the per frame cost of animating pickups with the old per pickup tick and the batched pass. Optional argument: number of pickups (default 300)."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&BenchmarkPickups));
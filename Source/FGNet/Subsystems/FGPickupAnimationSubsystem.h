@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "FGPickupAnimationSubsystem.generated.h"
+
+class AFGPickup;
+
+// Bobs and spins every pickup mesh in one pass, instead of one actor tick per pickup. The animation is purely
+// cosmetic, pickups never register on a dedicated server and only the ones that were recently rendered are moved.
+UCLASS(config = Game)
+class FGNET_API UFGPickupAnimationSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+public:
+	void RegisterPickup(AFGPickup* Pickup);
+	void UnregisterPickup(AFGPickup* Pickup);
+
+	// Moves the meshes of all active pickups to where they are at Time. With bOnlyVisible set, pickups that were not
+	// rendered recently are skipped.
+	void Animate(float Time, bool bOnlyVisible);
+
+	int32 GetNumPickups() const { return Pickups.Num(); }
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+	UPROPERTY(config)
+		float BobHeight = 30.0f;
+
+	UPROPERTY(config)
+		float BobFrequency = 0.65f;
+
+	// Degrees per second.
+	UPROPERTY(config)
+		float SpinSpeed = 20.0f;
+
+private:
+	UPROPERTY(Transient)
+		TArray<AFGPickup*> Pickups;
+};
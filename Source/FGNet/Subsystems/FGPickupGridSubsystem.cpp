@@ -0,0 +1,90 @@
+#include "FGPickupGridSubsystem.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "../FGNetStats.h"
+#include "../FGPickup.h"
+#include "../Player/FGPlayer.h"
+
+void UFGPickupGridSubsystem::RegisterPickup(AFGPickup* Pickup)
+{
+	if (Pickup == nullptr || Pickups.Contains(Pickup))
+		return;
+
+	Pickups.Add(Pickup);
+	Cells.FindOrAdd(GetCell(Pickup->GetPickupLocation())).Add(Pickup);
+	MaxPickupRadius = FMath::Max(MaxPickupRadius, Pickup->GetPickupRadius());
+}
+
+void UFGPickupGridSubsystem::UnregisterPickup(AFGPickup* Pickup)
+{
+	if (Pickups.RemoveSwap(Pickup) == 0)
+		return;
+
+	const FIntPoint Cell = GetCell(Pickup->GetPickupLocation());
+	if (TArray<AFGPickup*>* CellPickups = Cells.Find(Cell))
+	{
+		CellPickups->RemoveSwap(Pickup);
+		if (CellPickups->Num() == 0)
+		{
+			Cells.Remove(Cell);
+		}
+	}
+}
+
+void UFGPickupGridSubsystem::CollectPickups()
+{
+	FGNET_SCOPE_CYCLE_COUNTER(PickupCollection);
+
+	for (TActorIterator<AFGPlayer> It(GetWorld()); It; ++It)
+	{
+		AFGPlayer* Player = *It;
+		const FVector PlayerLocation = Player->GetActorLocation();
+		const float PlayerRadius = Player->GetCollisionRadius();
+		const FVector Extent(PlayerRadius + MaxPickupRadius);
+
+		const FIntPoint MinCell = GetCell(PlayerLocation - Extent);
+		const FIntPoint MaxCell = GetCell(PlayerLocation + Extent);
+
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+			{
+				const TArray<AFGPickup*>* CellPickups = Cells.Find(FIntPoint(X, Y));
+				if (CellPickups == nullptr)
+					continue;
+
+				for (AFGPickup* Pickup : *CellPickups)
+				{
+					if (Pickup->IsPickedUp())
+						continue;
+
+					const float TouchDistance = PlayerRadius + Pickup->GetPickupRadius();
+					if (FVector::DistSquared(PlayerLocation, Pickup->GetPickupLocation()) <= FMath::Square(TouchDistance))
+					{
+						Pickup->Collect(Player);
+					}
+				}
+			}
+		}
+	}
+}
+
+void UFGPickupGridSubsystem::Tick(float DeltaTime)
+{
+	CollectPickups();
+}
+
+bool UFGPickupGridSubsystem::IsTickable() const
+{
+	return !IsTemplate() && Pickups.Num() > 0;
+}
+
+TStatId UFGPickupGridSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFGPickupGridSubsystem, STATGROUP_Tickables);
+}
+
+FIntPoint UFGPickupGridSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
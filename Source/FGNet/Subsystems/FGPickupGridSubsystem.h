@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "FGPickupGridSubsystem.generated.h"
+
+class AFGPickup;
+
+// Server side pickup collection. Pickups are put in a uniform grid over the XY plane once, every server tick each
+// player is tested against the pickups in the cells around it. Replaces physics overlaps, pickups have no collision.
+UCLASS(config = Game)
+class FGNET_API UFGPickupGridSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+public:
+	void RegisterPickup(AFGPickup* Pickup);
+	void UnregisterPickup(AFGPickup* Pickup);
+
+	// Hands every pickup that a player touches to that player.
+	void CollectPickups();
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+	// Should be a few times the pickup radius, so a player only ever touches a handful of cells.
+	UPROPERTY(config)
+		float CellSize = 1000.0f;
+
+private:
+	FIntPoint GetCell(const FVector& Location) const;
+
+	UPROPERTY(Transient)
+		TArray<AFGPickup*> Pickups;
+
+	TMap<FIntPoint, TArray<AFGPickup*>> Cells;
+
+	// Largest pickup radius in the grid, a player has to look this much further than its own radius.
+	float MaxPickupRadius = 0.0f;
+};
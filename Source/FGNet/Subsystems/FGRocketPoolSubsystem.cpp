@@ -0,0 +1,122 @@
+#include "FGRocketPoolSubsystem.h"
+#include "Engine/World.h"
+#include "../FGRocket.h"
+#include "../FGNetStats.h"
+
+void UFGRocketPoolSubsystem::InitializePool(TSubclassOf<AFGRocket> InRocketClass)
+{
+	if (RocketClass != nullptr || InRocketClass == nullptr)
+		return;
+
+	RocketClass = InRocketClass;
+	Grow(InitialCapacity);
+}
+
+void UFGRocketPoolSubsystem::RegisterRocket(AFGRocket* Rocket)
+{
+	if (Rocket == nullptr || Rocket->PoolIndex != INDEX_NONE)
+		return;
+
+	Rocket->PoolIndex = Rockets.Add(Rocket);
+	Rocket->FreeListIndex = FreeRockets.Add(Rocket);
+}
+
+void UFGRocketPoolSubsystem::UnregisterRocket(AFGRocket* Rocket)
+{
+	if (Rocket == nullptr || Rocket->PoolIndex == INDEX_NONE)
+		return;
+
+	if (Rocket->FreeListIndex == INDEX_NONE)
+	{
+		ReleaseRocket(Rocket);
+	}
+
+	RemoveFromFreeList(Rocket);
+
+	const int32 Index = Rocket->PoolIndex;
+	Rockets.RemoveAtSwap(Index, 1, false);
+	if (Rockets.IsValidIndex(Index))
+	{
+		Rockets[Index]->PoolIndex = Index;
+	}
+
+	Rocket->PoolIndex = INDEX_NONE;
+}
+
+AFGRocket* UFGRocketPoolSubsystem::AcquireRocket(AActor* Owner, int32 MaxActivePerOwner)
+{
+	if (GetNumActiveRockets(Owner) >= MaxActivePerOwner)
+		return nullptr;
+
+	if (FreeRockets.Num() == 0 && !Grow(GrowCount))
+		return nullptr;
+
+	AFGRocket* Rocket = FreeRockets.Last();
+	RemoveFromFreeList(Rocket);
+	Rocket->PoolOwner = Owner;
+	NumActiveRocketsPerOwner.FindOrAdd(Owner)++;
+	NumActiveRockets++;
+	INC_DWORD_STAT(STAT_FGNet_ActiveRockets);
+	CSV_CUSTOM_STAT(FGNet, ActiveRockets, NumActiveRockets, ECsvCustomStatOp::Set);
+	return Rocket;
+}
+
+void UFGRocketPoolSubsystem::ReleaseRocket(AFGRocket* Rocket)
+{
+	if (Rocket == nullptr || Rocket->PoolIndex == INDEX_NONE || Rocket->FreeListIndex != INDEX_NONE)
+		return;
+
+	if (int32* NumActiveForOwner = NumActiveRocketsPerOwner.Find(Rocket->PoolOwner))
+	{
+		if (--(*NumActiveForOwner) <= 0)
+		{
+			NumActiveRocketsPerOwner.Remove(Rocket->PoolOwner);
+		}
+	}
+
+	Rocket->PoolOwner = nullptr;
+	Rocket->FreeListIndex = FreeRockets.Add(Rocket);
+	NumActiveRockets--;
+	DEC_DWORD_STAT(STAT_FGNet_ActiveRockets);
+	CSV_CUSTOM_STAT(FGNet, ActiveRockets, NumActiveRockets, ECsvCustomStatOp::Set);
+}
+
+int32 UFGRocketPoolSubsystem::GetNumActiveRockets(const AActor* Owner) const
+{
+	const int32* NumActiveForOwner = NumActiveRocketsPerOwner.Find(const_cast<AActor*>(Owner));
+	return NumActiveForOwner != nullptr ? *NumActiveForOwner : 0;
+}
+
+bool UFGRocketPoolSubsystem::Grow(int32 Count)
+{
+	UWorld* World = GetWorld();
+	if (RocketClass == nullptr || World == nullptr)
+		return false;
+
+	const int32 NumToSpawn = FMath::Min(Count, MaxCapacity - Rockets.Num());
+	for (int32 Index = 0; Index < NumToSpawn; ++Index)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		SpawnParams.ObjectFlags = RF_Transient;
+		// Registers itself with the pool in BeginPlay.
+		World->SpawnActor<AFGRocket>(RocketClass, FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+	}
+
+	return NumToSpawn > 0;
+}
+
+void UFGRocketPoolSubsystem::RemoveFromFreeList(AFGRocket* Rocket)
+{
+	const int32 Index = Rocket->FreeListIndex;
+	if (Index == INDEX_NONE)
+		return;
+
+	FreeRockets.RemoveAtSwap(Index, 1, false);
+	if (FreeRockets.IsValidIndex(Index))
+	{
+		FreeRockets[Index]->FreeListIndex = Index;
+	}
+
+	Rocket->FreeListIndex = INDEX_NONE;
+}
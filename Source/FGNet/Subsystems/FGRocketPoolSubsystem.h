@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "FGRocketPoolSubsystem.generated.h"
+
+class AFGRocket;
+
+// Rockets shared by every player in the world. Rockets aren't replicated, every machine spawns its own and keeps the
+// free ones in a free list so acquiring and releasing a rocket never has to scan the pool.
+UCLASS(config = Game)
+class FGNET_API UFGRocketPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	// Spawns the initial rockets the first time it's called.
+	void InitializePool(TSubclassOf<AFGRocket> InRocketClass);
+
+	// Rockets register themselves in BeginPlay. Unregistered rockets are never handed out and releasing them does nothing.
+	void RegisterRocket(AFGRocket* Rocket);
+	void UnregisterRocket(AFGRocket* Rocket);
+
+	// Takes any free rocket. Returns nullptr if Owner already has MaxActivePerOwner active rockets, or if the pool is
+	// empty and can't grow.
+	AFGRocket* AcquireRocket(AActor* Owner, int32 MaxActivePerOwner);
+
+	void ReleaseRocket(AFGRocket* Rocket);
+
+	TSubclassOf<AFGRocket> GetRocketClass() const { return RocketClass; }
+
+	int32 GetNumRockets() const { return Rockets.Num(); }
+	int32 GetNumActiveRockets() const { return NumActiveRockets; }
+	int32 GetNumActiveRockets(const AActor* Owner) const;
+
+	UPROPERTY(config)
+		int32 InitialCapacity = 32;
+
+	// Rockets spawned at a time when the pool runs out.
+	UPROPERTY(config)
+		int32 GrowCount = 8;
+
+	UPROPERTY(config)
+		int32 MaxCapacity = 256;
+
+private:
+	bool Grow(int32 Count);
+	void RemoveFromFreeList(AFGRocket* Rocket);
+
+	UPROPERTY(Transient)
+		TSubclassOf<AFGRocket> RocketClass;
+
+	UPROPERTY(Transient)
+		TArray<AFGRocket*> Rockets;
+
+	TArray<AFGRocket*> FreeRockets;
+
+	TMap<TWeakObjectPtr<AActor>, int32> NumActiveRocketsPerOwner;
+
+	int32 NumActiveRockets = 0;
+};
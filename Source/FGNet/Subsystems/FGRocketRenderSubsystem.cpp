@@ -0,0 +1,129 @@
+#include "FGRocketRenderSubsystem.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/World.h"
+#include "FGRocketSimulationSubsystem.h"
+#include "../FGRocket.h"
+#include "../FGNetStats.h"
+
+void UFGRocketRenderSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PostActorTickHandle = FWorldDelegates::OnWorldPostActorTick.AddUObject(this, &UFGRocketRenderSubsystem::OnWorldPostActorTick);
+}
+
+void UFGRocketRenderSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnWorldPostActorTick.Remove(PostActorTickHandle);
+
+	Super::Deinitialize();
+}
+
+void UFGRocketRenderSubsystem::AddRocket(AFGRocket* Rocket)
+{
+	if (Rocket->RenderIndex != INDEX_NONE || GetWorld()->GetNetMode() == NM_DedicatedServer)
+		return;
+
+	if (Instances == nullptr && !CreateInstances(Rocket))
+		return;
+
+	Rocket->RenderIndex = Rockets.Add(Rocket);
+}
+
+void UFGRocketRenderSubsystem::RemoveRocket(AFGRocket* Rocket)
+{
+	const int32 Index = Rocket->RenderIndex;
+	if (Index == INDEX_NONE)
+		return;
+
+	Rockets.RemoveAtSwap(Index, 1, false);
+	if (Rockets.IsValidIndex(Index))
+	{
+		Rockets[Index]->RenderIndex = Index;
+	}
+
+	Rocket->RenderIndex = INDEX_NONE;
+}
+
+void UFGRocketRenderSubsystem::UpdateInstances()
+{
+	if (Instances == nullptr)
+		return;
+
+	FGNET_SCOPE_CYCLE_COUNTER(RocketRender);
+
+	const int32 NumRockets = Rockets.Num();
+	InstanceTransforms.SetNum(NumRockets, false);
+	for (int32 Index = 0; Index < NumRockets; ++Index)
+	{
+		const AFGRocket* Rocket = Rockets[Index];
+		InstanceTransforms[Index] = MeshRelativeTransform * FTransform(Rocket->RenderFacing.ToOrientationQuat(), Rocket->RenderLocation);
+	}
+
+	// Instances aren't tied to a rocket, only their number changes when rockets are fired or explode. Removing from
+	// the end never shifts the other instances.
+	const int32 NumInstances = Instances->GetInstanceCount();
+	if (NumRockets == 0)
+	{
+		if (NumInstances > 0)
+			Instances->ClearInstances();
+		return;
+	}
+
+	for (int32 Index = NumInstances - 1; Index >= NumRockets; --Index)
+	{
+		Instances->RemoveInstance(Index);
+	}
+
+	for (int32 Index = NumInstances; Index < NumRockets; ++Index)
+	{
+		Instances->AddInstanceWorldSpace(InstanceTransforms[Index]);
+	}
+
+	Instances->BatchUpdateInstancesTransforms(0, InstanceTransforms, true, true, true);
+}
+
+void UFGRocketRenderSubsystem::OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaTime)
+{
+	if (InWorld != GetWorld())
+		return;
+
+	// Batched rockets move later in the frame, the rocket simulation subsystem updates the instances after them.
+	const UFGRocketSimulationSubsystem* RocketSimulation = InWorld->GetSubsystem<UFGRocketSimulationSubsystem>();
+	if (RocketSimulation == nullptr || RocketSimulation->GetNumRockets() == 0)
+	{
+		UpdateInstances();
+	}
+}
+
+bool UFGRocketRenderSubsystem::CreateInstances(const AFGRocket* Rocket)
+{
+	const UStaticMeshComponent* MeshTemplate = Rocket->GetMeshComponent();
+	if (MeshTemplate == nullptr || MeshTemplate->GetStaticMesh() == nullptr)
+		return false;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.ObjectFlags = RF_Transient;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	RenderActor = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+	if (RenderActor == nullptr)
+		return false;
+
+	Instances = NewObject<UInstancedStaticMeshComponent>(RenderActor, TEXT("RocketInstances"));
+	Instances->SetMobility(EComponentMobility::Movable);
+	Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Instances->SetGenerateOverlapEvents(false);
+	Instances->SetStaticMesh(MeshTemplate->GetStaticMesh());
+	Instances->SetCastShadow(MeshTemplate->CastShadow);
+	for (int32 MaterialIndex = 0; MaterialIndex < MeshTemplate->GetNumMaterials(); ++MaterialIndex)
+	{
+		Instances->SetMaterial(MaterialIndex, MeshTemplate->GetMaterial(MaterialIndex));
+	}
+
+	RenderActor->SetRootComponent(Instances);
+	Instances->RegisterComponent();
+
+	MeshRelativeTransform = MeshTemplate->GetRelativeTransform();
+	return true;
+}
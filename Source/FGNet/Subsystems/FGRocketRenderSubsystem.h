@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
+#include "FGRocketRenderSubsystem.generated.h"
+
+class AFGRocket;
+class UInstancedStaticMeshComponent;
+
+// Draws every rocket in flight as an instance of one instanced static mesh, instead of one mesh component per pooled
+// rocket. Instance transforms are rewritten in one batch after the rockets moved each frame, free rockets have no
+// render state at all. Nothing is registered on a dedicated server.
+UCLASS()
+class FGNET_API UFGRocketRenderSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	void AddRocket(AFGRocket* Rocket);
+	void RemoveRocket(AFGRocket* Rocket);
+
+	// Called once per frame after the rockets moved, by the rocket simulation subsystem when it's simulating rockets
+	// and after the actor ticks otherwise.
+	void UpdateInstances();
+
+	int32 GetNumRockets() const { return Rockets.Num(); }
+
+private:
+	void OnWorldPostActorTick(UWorld* InWorld, ELevelTick TickType, float DeltaTime);
+
+	// The instances look like the mesh component of the first rocket class that's drawn.
+	bool CreateInstances(const AFGRocket* Rocket);
+
+	UPROPERTY(Transient)
+		TArray<AFGRocket*> Rockets;
+
+	UPROPERTY(Transient)
+		AActor* RenderActor = nullptr;
+
+	UPROPERTY(Transient)
+		UInstancedStaticMeshComponent* Instances = nullptr;
+
+	FTransform MeshRelativeTransform;
+	TArray<FTransform> InstanceTransforms;
+
+	FDelegateHandle PostActorTickHandle;
+};
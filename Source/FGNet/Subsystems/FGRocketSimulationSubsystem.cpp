@@ -0,0 +1,236 @@
+#include "FGRocketSimulationSubsystem.h"
+#include "FGRocketPoolSubsystem.h"
+#include "FGRocketRenderSubsystem.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "../FGRocket.h"
+#include "../FGNet.h"
+#include "../FGNetStats.h"
+
+static TAutoConsoleVariable<int32> CVarBatchedRocketSimulation(
+	TEXT("FGNet.BatchedRocketSimulation"),
+	1,
+	TEXT("1: Moving rockets are simulated together by the rocket simulation subsystem.\n")
+	TEXT("0: Every moving rocket ticks itself."),
+	ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarRocketParallelThreshold(
+	TEXT("FGNet.RocketParallelThreshold"),
+	64,
+	TEXT("Number of moving rockets at which the batched rocket simulation is spread over worker threads."),
+	ECVF_Default);
+
+bool UFGRocketSimulationSubsystem::IsBatchingEnabled()
+{
+	return CVarBatchedRocketSimulation.GetValueOnGameThread() != 0;
+}
+
+void UFGRocketSimulationSubsystem::AddRocket(AFGRocket* Rocket)
+{
+	int32 Index = Rocket->SimulationIndex;
+	if (Index == INDEX_NONE)
+	{
+		Index = Rockets.Add(Rocket);
+		StartLocations.AddUninitialized();
+		FacingDirections.AddUninitialized();
+		FacingCorrections.AddUninitialized();
+		Distances.AddUninitialized();
+		LifeTimesLeft.AddUninitialized();
+		Velocities.AddUninitialized();
+		Locations.AddUninitialized();
+		Hits.AddDefaulted();
+		Rocket->SimulationIndex = Index;
+	}
+
+	StartLocations[Index] = Rocket->RocketStartLocation;
+	FacingDirections[Index] = Rocket->FacingRotationStart;
+	FacingCorrections[Index] = Rocket->FacingRotationCorrection;
+	Distances[Index] = 0.0f;
+	LifeTimesLeft[Index] = Rocket->LifeTime;
+	Velocities[Index] = Rocket->MovementVelocity;
+	Locations[Index] = Rocket->RocketStartLocation;
+	Hits[Index].Reset();
+}
+
+void UFGRocketSimulationSubsystem::RemoveRocket(AFGRocket* Rocket)
+{
+	if (Rocket->SimulationIndex == INDEX_NONE)
+		return;
+
+	RemoveAt(Rocket->SimulationIndex);
+	Rocket->SimulationIndex = INDEX_NONE;
+}
+
+void UFGRocketSimulationSubsystem::SetFacingCorrection(AFGRocket* Rocket, const FQuat& FacingCorrection)
+{
+	if (Rocket->SimulationIndex != INDEX_NONE)
+	{
+		FacingCorrections[Rocket->SimulationIndex] = FacingCorrection;
+	}
+}
+
+void UFGRocketSimulationSubsystem::Simulate(float DeltaTime)
+{
+	FGNET_SCOPE_CYCLE_COUNTER(RocketSimulation);
+
+	const int32 NumRockets = Rockets.Num();
+	if (NumRockets == 0)
+		return;
+
+	const bool bSingleThreaded = NumRockets < CVarRocketParallelThreshold.GetValueOnGameThread();
+
+	// Scene queries and lag compensation lookups are read only, every rocket can be moved and traced independently.
+	ParallelFor(NumRockets, [this, DeltaTime](int32 Index)
+	{
+		Locations[Index] = AFGRocket::Integrate(DeltaTime, Velocities[Index], StartLocations[Index], FacingCorrections[Index], FacingDirections[Index], Distances[Index], LifeTimesLeft[Index]);
+		Rockets[Index]->TraceHit(Locations[Index], FacingDirections[Index], Hits[Index]);
+	}, bSingleThreaded);
+
+	// Exploding frees the rocket and swaps the last one into its slot, walk backwards so nothing is skipped.
+	for (int32 Index = NumRockets - 1; Index >= 0; --Index)
+	{
+		AFGRocket* Rocket = Rockets[Index];
+		const bool bHit = Hits[Index].bBlockingHit;
+		const bool bExpired = LifeTimesLeft[Index] < 0.0f;
+
+		// The explosion spawns at the actor's location.
+		if (bHit || bExpired)
+			Rocket->SetActorLocation(Locations[Index]);
+
+		Rocket->SetRenderTransform(Locations[Index], FacingDirections[Index]);
+
+		Rocket->OnMoved(FacingDirections[Index]);
+
+		if (bHit)
+			Rocket->ExplodeHit(Hits[Index]);
+		else if (bExpired)
+			Rocket->Explode();
+	}
+}
+
+void UFGRocketSimulationSubsystem::Tick(float DeltaTime)
+{
+	Simulate(DeltaTime);
+
+	if (UFGRocketRenderSubsystem* RocketRender = GetWorld()->GetSubsystem<UFGRocketRenderSubsystem>())
+	{
+		RocketRender->UpdateInstances();
+	}
+}
+
+bool UFGRocketSimulationSubsystem::IsTickable() const
+{
+	return !IsTemplate() && Rockets.Num() > 0;
+}
+
+TStatId UFGRocketSimulationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFGRocketSimulationSubsystem, STATGROUP_Tickables);
+}
+
+void UFGRocketSimulationSubsystem::RemoveAt(int32 Index)
+{
+	Rockets.RemoveAtSwap(Index, 1, false);
+	StartLocations.RemoveAtSwap(Index, 1, false);
+	FacingDirections.RemoveAtSwap(Index, 1, false);
+	FacingCorrections.RemoveAtSwap(Index, 1, false);
+	Distances.RemoveAtSwap(Index, 1, false);
+	LifeTimesLeft.RemoveAtSwap(Index, 1, false);
+	Velocities.RemoveAtSwap(Index, 1, false);
+	Locations.RemoveAtSwap(Index, 1, false);
+	Hits.RemoveAtSwap(Index, 1, false);
+
+	if (Rockets.IsValidIndex(Index))
+	{
+		Rockets[Index]->SimulationIndex = Index;
+	}
+}
+
+// Compares the per-actor rocket tick with the batched simulation, run it in a standalone game or on a server.
+static void BenchmarkRockets(const TArray<FString>& Args, UWorld* World)
+{
+	if (World == nullptr || World->IsNetMode(NM_Client))
+	{
+		UE_LOG(LogFGNet, Warning, TEXT("FGNet.BenchmarkRockets needs a world with authority."));
+		return;
+	}
+
+	UFGRocketSimulationSubsystem* RocketSimulation = World->GetSubsystem<UFGRocketSimulationSubsystem>();
+	UFGRocketPoolSubsystem* RocketPool = World->GetSubsystem<UFGRocketPoolSubsystem>();
+	if (RocketSimulation == nullptr || RocketPool == nullptr)
+		return;
+
+	// Rockets live for two seconds, keep the run short enough that none of them expire.
+	const int32 NumFrames = Args.Num() > 0 ? FMath::Clamp(FCString::Atoi(*Args[0]), 1, 100) : 60;
+	const float DeltaTime = 1.0f / 60.0f;
+	const TSubclassOf<AFGRocket> RocketClass = RocketPool->GetRocketClass() != nullptr ? RocketPool->GetRocketClass() : TSubclassOf<AFGRocket>(AFGRocket::StaticClass());
+	IConsoleVariable* BatchingVariable = CVarBatchedRocketSimulation.AsVariable();
+	const int32 OldBatchingValue = BatchingVariable->GetInt();
+
+	for (const int32 NumRockets : { 10, 100, 1000 })
+	{
+		TArray<AFGRocket*> BenchmarkRockets;
+		for (int32 Index = 0; Index < NumRockets; ++Index)
+		{
+			FActorSpawnParameters SpawnParams;
+			SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+			SpawnParams.ObjectFlags = RF_Transient;
+			AFGRocket* Rocket = World->SpawnActor<AFGRocket>(RocketClass, FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+
+			// Registered itself in BeginPlay, the pool must not hand it out for a real shot while it flies here.
+			RocketPool->UnregisterRocket(Rocket);
+			BenchmarkRockets.Add(Rocket);
+		}
+
+		// High above the level so the traces run but never hit anything.
+		auto StartRockets = [&BenchmarkRockets]()
+		{
+			for (int32 Index = 0; Index < BenchmarkRockets.Num(); ++Index)
+			{
+				BenchmarkRockets[Index]->StartMoving(FVector::ForwardVector, FVector(0.0f, Index * 50.0f, 100000.0f));
+			}
+		};
+
+		BatchingVariable->Set(0, ECVF_SetByCode);
+		StartRockets();
+
+		const double PerActorStart = FPlatformTime::Seconds();
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			for (AFGRocket* Rocket : BenchmarkRockets)
+			{
+				Rocket->Tick(DeltaTime);
+			}
+		}
+		const double PerActorSeconds = FPlatformTime::Seconds() - PerActorStart;
+
+		BatchingVariable->Set(1, ECVF_SetByCode);
+		StartRockets();
+
+		const double BatchedStart = FPlatformTime::Seconds();
+		for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+		{
+			RocketSimulation->Simulate(DeltaTime);
+		}
+		const double BatchedSeconds = FPlatformTime::Seconds() - BatchedStart;
+
+		for (AFGRocket* Rocket : BenchmarkRockets)
+		{
+			Rocket->MakeFree();
+			Rocket->Destroy();
+		}
+
+		UE_LOG(LogFGNet, Display, TEXT("%4d rockets: per actor tick %.3f ms/frame, batched %.3f ms/frame"),
+			NumRockets, PerActorSeconds * 1000.0 / NumFrames, BatchedSeconds * 1000.0 / NumFrames);
+	}
+
+	BatchingVariable->Set(OldBatchingValue, ECVF_SetByCode);
+
+	UE_LOG(LogFGNet, Display, TEXT("Per actor numbers exclude the tick function dispatch the engine adds for every ticking actor."));
+}
+
+static FAutoConsoleCommandWithWorldAndArgs BenchmarkRocketsCommand(
+	TEXT("FGNet.BenchmarkRockets"),
+	TEXT("Measures the per frame cost of 10, 100 and 1000 moving rockets with the per actor tick and the batched simulation. Optional argument: number of frames (max 100)."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&BenchmarkRockets));
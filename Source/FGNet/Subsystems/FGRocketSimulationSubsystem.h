@@ -0,0 +1,48 @@
+#pragma once
+
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "FGRocketSimulationSubsystem.generated.h"
+
+class AFGRocket;
+
+// Simulates every moving rocket in the world in one pass instead of one actor tick per rocket. Rocket state is kept
+// in parallel arrays that are integrated and traced together, spread over worker threads once there are enough
+// rockets to pay for it. Rockets are drawn by the rocket render subsystem, actor transforms are only written when a
+// rocket explodes.
+UCLASS()
+class FGNET_API UFGRocketSimulationSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+public:
+	static bool IsBatchingEnabled();
+
+	void AddRocket(AFGRocket* Rocket);
+	void RemoveRocket(AFGRocket* Rocket);
+	void SetFacingCorrection(AFGRocket* Rocket, const FQuat& FacingCorrection);
+
+	// Advances every rocket by DeltaTime and explodes the ones that hit something or ran out of life time.
+	void Simulate(float DeltaTime);
+
+	int32 GetNumRockets() const { return Rockets.Num(); }
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+private:
+	void RemoveAt(int32 Index);
+
+	UPROPERTY(Transient)
+		TArray<AFGRocket*> Rockets;
+
+	TArray<FVector> StartLocations;
+	TArray<FVector> FacingDirections;
+	TArray<FQuat> FacingCorrections;
+	TArray<float> Distances;
+	TArray<float> LifeTimesLeft;
+	TArray<float> Velocities;
+	TArray<FVector> Locations;
+	TArray<FHitResult> Hits;
+};